@@ -0,0 +1,97 @@
+// Copyright Tirefly. All Rights Reserved.
+
+
+#include "TireflyActorLifetimeWheel.h"
+
+#include "GameFramework/Actor.h"
+
+
+
+FTireflyActorLifetimeWheel::FTireflyActorLifetimeWheel(double InSlotDuration, int32 InNumSlots)
+	: SlotDuration(FMath::Max(InSlotDuration, UE_KINDA_SMALL_NUMBER))
+{
+	Slots.SetNum(FMath::Max(InNumSlots, 1));
+}
+
+void FTireflyActorLifetimeWheel::Schedule(const AActor* Actor, double ExpireTime)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	const uint32 Serial = NextSerial++;
+	ScheduledActors.Add(Actor, FSchedule{ ExpireTime, Serial });
+
+	// 已经处理过的刻度不会再被访问，过期时间落在其中的条目放到下一个刻度
+	const int64 Tick = FMath::Max(ExpireTimeToTick(ExpireTime), CurrentTick + 1);
+	Slots[TickToSlot(Tick)].Add(FEntry{ Actor, ExpireTime, Serial });
+}
+
+bool FTireflyActorLifetimeWheel::Cancel(const AActor* Actor)
+{
+	return ScheduledActors.Remove(Actor) > 0;
+}
+
+double FTireflyActorLifetimeWheel::GetExpireTime(const AActor* Actor) const
+{
+	const FSchedule* Schedule = ScheduledActors.Find(Actor);
+	return Schedule ? Schedule->ExpireTime : -1.0;
+}
+
+void FTireflyActorLifetimeWheel::Advance(double CurrentTime, TArray<AActor*>& OutExpiredActors)
+{
+	const int64 TargetTick = FMath::FloorToInt64(CurrentTime / SlotDuration);
+	if (TargetTick <= CurrentTick)
+	{
+		return;
+	}
+
+	// 落后超过一圈时每个槽位只需处理一次
+	const int64 FirstTick = FMath::Max(CurrentTick + 1, TargetTick - Slots.Num() + 1);
+	for (int64 Tick = FirstTick; Tick <= TargetTick; ++Tick)
+	{
+		ProcessSlot(Slots[TickToSlot(Tick)], CurrentTime, OutExpiredActors);
+	}
+
+	CurrentTick = TargetTick;
+}
+
+void FTireflyActorLifetimeWheel::Empty()
+{
+	for (TArray<FEntry>& Slot : Slots)
+	{
+		Slot.Empty();
+	}
+	ScheduledActors.Empty();
+	CurrentTick = INDEX_NONE;
+}
+
+void FTireflyActorLifetimeWheel::ProcessSlot(TArray<FEntry>& Slot, double CurrentTime, TArray<AActor*>& OutExpiredActors)
+{
+	for (int32 Index = Slot.Num() - 1; Index >= 0; --Index)
+	{
+		const FEntry& Entry = Slot[Index];
+
+		const FSchedule* Schedule = ScheduledActors.Find(Entry.Actor);
+		if (!Schedule || Schedule->Serial != Entry.Serial)
+		{
+			// 已被取消或刷新的旧条目
+			Slot.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		if (Entry.ExpireTime > CurrentTime)
+		{
+			// 属于之后的轮次
+			continue;
+		}
+
+		if (AActor* Actor = Entry.Actor.ResolveObjectPtr())
+		{
+			OutExpiredActors.Add(Actor);
+		}
+		ScheduledActors.Remove(Entry.Actor);
+		Slot.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+}
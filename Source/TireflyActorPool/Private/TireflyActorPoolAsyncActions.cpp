@@ -0,0 +1,203 @@
+// Copyright Tirefly. All Rights Reserved.
+
+
+#include "TireflyActorPoolAsyncActions.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "TireflyActorPoolLogChannels.h"
+#include "TireflyActorPoolWorldSubsystem.h"
+
+
+
+UTireflyAsyncAction_SpawnActorFromPool* UTireflyAsyncAction_SpawnActorFromPool::SpawnActorFromPoolAsync(
+	const UObject* WorldContext,
+	TSoftClassPtr<AActor> ActorClass,
+	FName ActorId,
+	const FTransform& SpawnTransform,
+	const FInstancedStruct& InitialData,
+	float Lifetime,
+	ESpawnActorCollisionHandlingMethod CollisionHandling,
+	AActor* Owner,
+	APawn* Instigator)
+{
+	UTireflyAsyncAction_SpawnActorFromPool* Action = NewObject<UTireflyAsyncAction_SpawnActorFromPool>();
+	Action->World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull);
+	Action->ActorClass = ActorClass;
+	Action->ActorId = ActorId;
+	Action->SpawnTransform = SpawnTransform;
+	Action->InitialData = InitialData;
+	Action->Lifetime = Lifetime;
+	Action->CollisionHandling = CollisionHandling;
+	Action->Owner = Owner;
+	Action->Instigator = Instigator;
+	Action->RegisterWithGameInstance(WorldContext);
+
+	return Action;
+}
+
+void UTireflyAsyncAction_SpawnActorFromPool::Activate()
+{
+	UTireflyActorPoolWorldSubsystem* SubsystemAP = World.IsValid() ? World->GetSubsystem<UTireflyActorPoolWorldSubsystem>() : nullptr;
+	if (!SubsystemAP)
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid Subsystem"), *FString(__FUNCTION__));
+		OnFailed.Broadcast(nullptr);
+		SetReadyToDestroy();
+		return;
+	}
+
+	SubsystemAP->SpawnActorFromPoolAsync(
+		ActorClass,
+		ActorId,
+		SpawnTransform,
+		InitialData,
+		Lifetime,
+		CollisionHandling,
+		Owner.Get(),
+		Instigator.Get(),
+		[WeakThis = TWeakObjectPtr<UTireflyAsyncAction_SpawnActorFromPool>(this)](AActor* Actor)
+		{
+			UTireflyAsyncAction_SpawnActorFromPool* Action = WeakThis.Get();
+			if (!Action)
+			{
+				return;
+			}
+
+			if (IsValid(Actor))
+			{
+				Action->OnSpawned.Broadcast(Actor);
+			}
+			else
+			{
+				Action->OnFailed.Broadcast(nullptr);
+			}
+			Action->SetReadyToDestroy();
+		});
+}
+
+UTireflyAsyncAction_WarmUpActorPool* UTireflyAsyncAction_WarmUpActorPool::WarmUpActorPoolAsync(
+	const UObject* WorldContext,
+	TSoftClassPtr<AActor> ActorClass,
+	FName ActorId,
+	int32 Count,
+	int32 Priority)
+{
+	UTireflyAsyncAction_WarmUpActorPool* Action = NewObject<UTireflyAsyncAction_WarmUpActorPool>();
+	Action->World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull);
+	Action->ActorClass = ActorClass;
+	Action->ActorId = ActorId;
+	Action->Count = Count;
+	Action->Priority = Priority;
+	Action->RegisterWithGameInstance(WorldContext);
+
+	return Action;
+}
+
+void UTireflyAsyncAction_WarmUpActorPool::Activate()
+{
+	UTireflyActorPoolWorldSubsystem* SubsystemAP = World.IsValid() ? World->GetSubsystem<UTireflyActorPoolWorldSubsystem>() : nullptr;
+	if (!SubsystemAP)
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid Subsystem"), *FString(__FUNCTION__));
+		OnFailed.Broadcast();
+		SetReadyToDestroy();
+		return;
+	}
+
+	SubsystemAP->WarmUpActorPoolAsync(
+		ActorClass,
+		ActorId,
+		Count,
+		Priority,
+		[WeakThis = TWeakObjectPtr<UTireflyAsyncAction_WarmUpActorPool>(this)](bool bSucceeded)
+		{
+			UTireflyAsyncAction_WarmUpActorPool* Action = WeakThis.Get();
+			if (!Action)
+			{
+				return;
+			}
+
+			if (bSucceeded)
+			{
+				Action->OnCompleted.Broadcast();
+			}
+			else
+			{
+				Action->OnFailed.Broadcast();
+			}
+			Action->SetReadyToDestroy();
+		});
+}
+
+UTireflyAsyncAction_SpawnActorFromPoolDeferred* UTireflyAsyncAction_SpawnActorFromPoolDeferred::SpawnActorFromPoolDeferred(
+	const UObject* WorldContext,
+	TSubclassOf<AActor> ActorClass,
+	FName ActorId,
+	const FTransform& SpawnTransform,
+	const FInstancedStruct& InitialData,
+	int32 Priority,
+	bool bDroppable,
+	float Lifetime,
+	ESpawnActorCollisionHandlingMethod CollisionHandling,
+	AActor* Owner,
+	APawn* Instigator)
+{
+	UTireflyAsyncAction_SpawnActorFromPoolDeferred* Action = NewObject<UTireflyAsyncAction_SpawnActorFromPoolDeferred>();
+	Action->World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull);
+	Action->ActorClass = ActorClass;
+	Action->ActorId = ActorId;
+	Action->SpawnTransform = SpawnTransform;
+	Action->InitialData = InitialData;
+	Action->Priority = Priority;
+	Action->bDroppable = bDroppable;
+	Action->Lifetime = Lifetime;
+	Action->CollisionHandling = CollisionHandling;
+	Action->Owner = Owner;
+	Action->Instigator = Instigator;
+	Action->RegisterWithGameInstance(WorldContext);
+
+	return Action;
+}
+
+void UTireflyAsyncAction_SpawnActorFromPoolDeferred::Activate()
+{
+	UTireflyActorPoolWorldSubsystem* SubsystemAP = World.IsValid() ? World->GetSubsystem<UTireflyActorPoolWorldSubsystem>() : nullptr;
+	if (!SubsystemAP)
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid Subsystem"), *FString(__FUNCTION__));
+		OnFailed.Broadcast(nullptr);
+		SetReadyToDestroy();
+		return;
+	}
+
+	SubsystemAP->SpawnActorFromPoolDeferred(
+		ActorClass,
+		ActorId,
+		SpawnTransform,
+		InitialData,
+		Lifetime,
+		CollisionHandling,
+		Owner.Get(),
+		Instigator.Get(),
+		Priority,
+		bDroppable,
+		[WeakThis = TWeakObjectPtr<UTireflyAsyncAction_SpawnActorFromPoolDeferred>(this)](AActor* Actor)
+		{
+			UTireflyAsyncAction_SpawnActorFromPoolDeferred* Action = WeakThis.Get();
+			if (!Action)
+			{
+				return;
+			}
+
+			if (IsValid(Actor))
+			{
+				Action->OnSpawned.Broadcast(Actor);
+			}
+			else
+			{
+				Action->OnFailed.Broadcast(nullptr);
+			}
+			Action->SetReadyToDestroy();
+		});
+}
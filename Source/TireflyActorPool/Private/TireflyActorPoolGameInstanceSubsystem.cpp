@@ -0,0 +1,35 @@
+// Copyright Tirefly. All Rights Reserved.
+
+
+#include "TireflyActorPoolGameInstanceSubsystem.h"
+
+
+
+void UTireflyActorPoolGameInstanceSubsystem::StashPersistentActorPools(TConstArrayView<FTireflyPersistentActorPool> Pools)
+{
+	for (const FTireflyPersistentActorPool& Pool : Pools)
+	{
+		const int32 ExistingIndex = PersistentActorPools.IndexOfByPredicate([&Pool](const FTireflyPersistentActorPool& Other)
+		{
+			return Other.IsSamePool(Pool);
+		});
+		if (ExistingIndex != INDEX_NONE)
+		{
+			PersistentActorPools[ExistingIndex] = Pool;
+		}
+		else
+		{
+			PersistentActorPools.Add(Pool);
+		}
+	}
+}
+
+TArray<FTireflyPersistentActorPool> UTireflyActorPoolGameInstanceSubsystem::TakePersistentActorPools()
+{
+	return MoveTemp(PersistentActorPools);
+}
+
+void UTireflyActorPoolGameInstanceSubsystem::ClearPersistentActorPools()
+{
+	PersistentActorPools.Empty();
+}
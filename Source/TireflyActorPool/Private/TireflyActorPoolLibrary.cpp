@@ -10,10 +10,91 @@
 
 #include "NiagaraComponent.h"
 #include "TireflyActorPoolLogChannels.h"
+#include "TireflyActorPoolStats.h"
 #include "TireflyActorPoolWorldSubsystem.h"
 #include "Particles/ParticleSystemComponent.h"
 
 
+namespace TireflyActorPool
+{
+	using FPooledActorComponentsRef = TSharedRef<FTireflyPooledActorComponents, ESPMode::NotThreadSafe>;
+
+	// 按类型把Actor的组件分组，重新构建时从旧列表继承已经记录的物理模拟标记
+	static FPooledActorComponentsRef BuildPooledActorComponents(const AActor* Actor, const FTireflyPooledActorComponents* PreviousComponents)
+	{
+		FPooledActorComponentsRef Components = MakeShared<FTireflyPooledActorComponents, ESPMode::NotThreadSafe>();
+		Components->OwnedComponentNum = Actor->GetComponents().Num();
+
+		for (UActorComponent* Component : Actor->GetComponents())
+		{
+			if (!Component)
+			{
+				continue;
+			}
+
+			FTireflyPooledActorComponents::FEntry Entry;
+			Entry.Component = Component;
+			Entry.bAutoActivate = Component->bAutoActivate;
+
+			// 分类顺序与原先的Cast链一致
+			if (Component->IsA<UParticleSystemComponent>())
+			{
+				Components->ParticleSystems.Add(Entry);
+			}
+			else if (Component->IsA<UNiagaraComponent>())
+			{
+				Components->Niagaras.Add(Entry);
+			}
+			else if (const UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Component))
+			{
+				Entry.bPhysicsEverEnabled = Primitive->IsSimulatingPhysics() || Primitive->BodyInstance.bSimulatePhysics;
+				if (PreviousComponents && !Entry.bPhysicsEverEnabled)
+				{
+					const FTireflyPooledActorComponents::FEntry* PreviousEntry = PreviousComponents->Primitives.FindByPredicate(
+						[Component](const FTireflyPooledActorComponents::FEntry& Previous) { return Previous.Component == Component; });
+					Entry.bPhysicsEverEnabled = PreviousEntry && PreviousEntry->bPhysicsEverEnabled;
+				}
+				Components->Primitives.Add(Entry);
+			}
+			else if (Component->IsA<UMovementComponent>())
+			{
+				Components->Movements.Add(Entry);
+				if (Component->IsA<UProjectileMovementComponent>())
+				{
+					Components->ProjectileMovements.Add(Entry);
+				}
+			}
+			else
+			{
+				Components->Others.Add(Entry);
+			}
+		}
+
+		return Components;
+	}
+
+	// 获取Actor的组件列表：对象池Actor使用记录中缓存的列表，组件数量变化时重新构建；其他Actor每次临时构建
+	static FPooledActorComponentsRef GetPooledActorComponents(AActor* Actor)
+	{
+		UWorld* World = Actor->GetWorld();
+		UTireflyActorPoolWorldSubsystem* ActorPoolSubsystem = World ? World->GetSubsystem<UTireflyActorPoolWorldSubsystem>() : nullptr;
+		TSharedPtr<FTireflyPooledActorComponents, ESPMode::NotThreadSafe>* CachedComponents = ActorPoolSubsystem
+			? ActorPoolSubsystem->FindPooledActorComponents(Actor)
+			: nullptr;
+		if (!CachedComponents)
+		{
+			return BuildPooledActorComponents(Actor, nullptr);
+		}
+
+		if (!CachedComponents->IsValid() || (*CachedComponents)->OwnedComponentNum != Actor->GetComponents().Num())
+		{
+			*CachedComponents = BuildPooledActorComponents(Actor, CachedComponents->Get());
+		}
+
+		return CachedComponents->ToSharedRef();
+	}
+}
+
 
 AActor* UTireflyActorPoolLibrary::SpawnActorFromPool(
 	const UObject* WorldContext,
@@ -79,6 +160,46 @@ AActor* UTireflyActorPoolLibrary::SpawnActorFromPoolWithParams(const UObject* Wo
 		Instigator);
 }
 
+void UTireflyActorPoolLibrary::SpawnActorsFromPool(
+	const UObject* WorldContext,
+	TSubclassOf<AActor> ActorClass,
+	FName ActorId,
+	const TArray<FTransform>& SpawnTransforms,
+	const TArray<FInstancedStruct>& InitialData,
+	TArray<AActor*>& OutActors,
+	float Lifetime,
+	ESpawnActorCollisionHandlingMethod CollisionHandling,
+	AActor* Owner,
+	APawn* Instigator)
+{
+	OutActors.Reset();
+
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid World"), *FString(__FUNCTION__));
+		return;
+	}
+
+	UTireflyActorPoolWorldSubsystem* SubsystemAP = World->GetSubsystem<UTireflyActorPoolWorldSubsystem>();
+	if (!SubsystemAP)
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid Subsystem"), *FString(__FUNCTION__));
+		return;
+	}
+
+	SubsystemAP->SpawnActorsFromPool(
+		ActorClass,
+		ActorId,
+		SpawnTransforms,
+		OutActors,
+		InitialData,
+		Lifetime,
+		CollisionHandling,
+		Owner,
+		Instigator);
+}
+
 void UTireflyActorPoolLibrary::RecycleActorToPool(const UObject* WorldContext, AActor* Actor)
 {
 	UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull);
@@ -121,85 +242,255 @@ void UTireflyActorPoolLibrary::WarmUpActorPool(
 	SubsystemAP->WarmUpActorPool(ActorClass, ActorId, Count);
 }
 
-void UTireflyActorPoolLibrary::ProcessComponent(UActorComponent* Component, bool bActivate)
+int32 UTireflyActorPoolLibrary::QueueWarmUpActorPool(
+	const UObject* WorldContext,
+	TSubclassOf<AActor> ActorClass,
+	FName ActorId,
+	const FTireflyActorPoolWarmUpCompletedDelegate& OnCompleted,
+	int32 Count,
+	int32 Priority)
 {
-	if (!Component)
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid World"), *FString(__FUNCTION__));
+		return INDEX_NONE;
+	}
+
+	UTireflyActorPoolWorldSubsystem* SubsystemAP = World->GetSubsystem<UTireflyActorPoolWorldSubsystem>();
+	if (!SubsystemAP)
 	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid Subsystem"), *FString(__FUNCTION__));
+		return INDEX_NONE;
+	}
+
+	return SubsystemAP->K2_QueueWarmUpActorPool(ActorClass, ActorId, OnCompleted, Count, Priority);
+}
+
+UActorComponent* UTireflyActorPoolLibrary::SpawnComponentFromPool(
+	const UObject* WorldContext,
+	TSubclassOf<UActorComponent> ComponentClass,
+	AActor* Owner,
+	const FTransform& RelativeTransform,
+	const FInstancedStruct& InitialData,
+	USceneComponent* AttachParent,
+	FName SocketName)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid World"), *FString(__FUNCTION__));
+		return nullptr;
+	}
+
+	UTireflyActorPoolWorldSubsystem* SubsystemAP = World->GetSubsystem<UTireflyActorPoolWorldSubsystem>();
+	if (!SubsystemAP)
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid Subsystem"), *FString(__FUNCTION__));
+		return nullptr;
+	}
+
+	return SubsystemAP->SpawnComponentFromPool(
+		ComponentClass,
+		Owner,
+		RelativeTransform,
+		AttachParent,
+		SocketName,
+		InitialData.IsValid() ? &InitialData : nullptr);
+}
+
+UObject* UTireflyActorPoolLibrary::SpawnObjectFromPool(
+	const UObject* WorldContext,
+	TSubclassOf<UObject> ObjectClass,
+	UObject* Outer,
+	const FInstancedStruct& InitialData)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid World"), *FString(__FUNCTION__));
+		return nullptr;
+	}
+
+	UTireflyActorPoolWorldSubsystem* SubsystemAP = World->GetSubsystem<UTireflyActorPoolWorldSubsystem>();
+	if (!SubsystemAP)
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid Subsystem"), *FString(__FUNCTION__));
+		return nullptr;
+	}
+
+	return SubsystemAP->SpawnObjectFromPool(ObjectClass, Outer, InitialData.IsValid() ? &InitialData : nullptr);
+}
+
+void UTireflyActorPoolLibrary::RecycleObjectToPool(const UObject* WorldContext, UObject* Object)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid World"), *FString(__FUNCTION__));
 		return;
 	}
 
-	if (UParticleSystemComponent* ParticleSystem = Cast<UParticleSystemComponent>(Component))
+	UTireflyActorPoolWorldSubsystem* SubsystemAP = World->GetSubsystem<UTireflyActorPoolWorldSubsystem>();
+	if (!SubsystemAP)
 	{
-		if (bActivate)
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid Subsystem"), *FString(__FUNCTION__));
+		return;
+	}
+
+	SubsystemAP->RecycleObjectToPool(Object);
+}
+
+void UTireflyActorPoolLibrary::WarmUpObjectPool(const UObject* WorldContext, TSubclassOf<UObject> ObjectClass, int32 Count)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid World"), *FString(__FUNCTION__));
+		return;
+	}
+
+	UTireflyActorPoolWorldSubsystem* SubsystemAP = World->GetSubsystem<UTireflyActorPoolWorldSubsystem>();
+	if (!SubsystemAP)
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid Subsystem"), *FString(__FUNCTION__));
+		return;
+	}
+
+	SubsystemAP->WarmUpObjectPool(ObjectClass, Count);
+}
+
+void UTireflyActorPoolLibrary::ProcessComponents(AActor* Actor, bool bActivate)
+{
+	// 之后的组件回调可能重入并重新构建列表，只通过本地持有的引用访问列表
+	const TireflyActorPool::FPooledActorComponentsRef ComponentsRef = TireflyActorPool::GetPooledActorComponents(Actor);
+	FTireflyPooledActorComponents& Components = ComponentsRef.Get();
+
+	// 列表中的组件已经被销毁时（数量不变的情况下先移除再添加了组件），下一次使用前重新构建
+	bool bStale = false;
+
+	for (const FTireflyPooledActorComponents::FEntry& Entry : Components.ParticleSystems)
+	{
+		UParticleSystemComponent* ParticleSystem = static_cast<UParticleSystemComponent*>(Entry.Component.Get());
+		if (!ParticleSystem)
 		{
-			ParticleSystem->SetActive(true, true);
-			ParticleSystem->ActivateSystem();
+			bStale = true;
+			continue;
 		}
-		else
+
+		if (!bActivate)
 		{
 			ParticleSystem->DeactivateSystem();
-			Component->SetActive(false);
+			ParticleSystem->SetActive(false);
+		}
+		else if (Entry.bAutoActivate)
+		{
+			ParticleSystem->SetActive(true, true);
+			ParticleSystem->ActivateSystem();
 		}
-		return;
 	}
 
-	if (UNiagaraComponent* Niagara = Cast<UNiagaraComponent>(Component))
+	for (const FTireflyPooledActorComponents::FEntry& Entry : Components.Niagaras)
 	{
-		if (bActivate)
+		UNiagaraComponent* Niagara = static_cast<UNiagaraComponent*>(Entry.Component.Get());
+		if (!Niagara)
 		{
-			Niagara->SetActive(true, true);
-			Niagara->ActivateSystem();
+			bStale = true;
+			continue;
 		}
-		else
+
+		if (!bActivate)
 		{
 			Niagara->DeactivateImmediate();
-			Component->SetActive(false);
+			Niagara->SetActive(false);
+		}
+		else if (Entry.bAutoActivate)
+		{
+			Niagara->SetActive(true, true);
+			Niagara->ActivateSystem();
 		}
-		return;
 	}
 
-	if (UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Component))
+	for (FTireflyPooledActorComponents::FEntry& Entry : Components.Primitives)
 	{
-		if (bActivate)
+		UPrimitiveComponent* Primitive = static_cast<UPrimitiveComponent*>(Entry.Component.Get());
+		if (!Primitive)
 		{
-			Primitive->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
-			Primitive->SetPhysicsLinearVelocity(FVector::ZeroVector);
-			Primitive->SetComponentTickEnabled(true);
-			Primitive->SetVisibility(true, true);
-			Primitive->SetActive(true, true);
+			bStale = true;
+			continue;
 		}
-		else
+
+		// 只有开启过物理模拟的组件才需要清除速度，物理相关的调用开销较大
+		if (!bActivate && !Entry.bPhysicsEverEnabled && Primitive->IsSimulatingPhysics())
+		{
+			Entry.bPhysicsEverEnabled = true;
+		}
+		if (Entry.bPhysicsEverEnabled)
 		{
 			Primitive->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
 			Primitive->SetPhysicsLinearVelocity(FVector::ZeroVector);
-			Primitive->SetComponentTickEnabled(false);
-			Primitive->SetSimulatePhysics(false);
-			Primitive->SetVisibility(false, true);
-			Component->SetActive(false);
+			if (!bActivate)
+			{
+				Primitive->SetSimulatePhysics(false);
+			}
 		}
-		return;
+
+		Primitive->SetComponentTickEnabled(bActivate);
+		Primitive->SetVisibility(bActivate, true);
+		Primitive->SetActive(bActivate, bActivate);
 	}
 
-	if (UMovementComponent* Movement = Cast<UMovementComponent>(Component))
+	for (const FTireflyPooledActorComponents::FEntry& Entry : Components.Movements)
 	{
+		UMovementComponent* Movement = static_cast<UMovementComponent*>(Entry.Component.Get());
+		if (!Movement)
+		{
+			bStale = true;
+			continue;
+		}
+
 		if (bActivate)
 		{
-			Movement->SetUpdatedComponent(Movement->GetOwner()->GetRootComponent());
+			Movement->SetUpdatedComponent(Actor->GetRootComponent());
 			Movement->SetActive(true, true);
-			if (UProjectileMovementComponent* ProjectileMovement = Cast<UProjectileMovementComponent>(Movement))
-			{
-				ProjectileMovement->SetVelocityInLocalSpace(FVector::XAxisVector * ProjectileMovement->InitialSpeed);
-			}
 		}
 		else
 		{
 			Movement->StopMovementImmediately();
 			Movement->SetUpdatedComponent(nullptr);
 		}
-		return;
 	}
 
-	Component->SetActive(bActivate, true);
+	if (bActivate)
+	{
+		for (const FTireflyPooledActorComponents::FEntry& Entry : Components.ProjectileMovements)
+		{
+			if (UProjectileMovementComponent* ProjectileMovement = static_cast<UProjectileMovementComponent*>(Entry.Component.Get()))
+			{
+				ProjectileMovement->SetVelocityInLocalSpace(FVector::XAxisVector * ProjectileMovement->InitialSpeed);
+			}
+		}
+	}
+
+	for (const FTireflyPooledActorComponents::FEntry& Entry : Components.Others)
+	{
+		UActorComponent* Component = Entry.Component.Get();
+		if (!Component)
+		{
+			bStale = true;
+			continue;
+		}
+
+		if (!bActivate || Entry.bAutoActivate)
+		{
+			Component->SetActive(bActivate, true);
+		}
+	}
+
+	if (bStale)
+	{
+		Components.OwnedComponentNum = INDEX_NONE;
+	}
 }
 
 void UTireflyActorPoolLibrary::ProcessPawnController(APawn* Pawn, bool bActivate)
@@ -237,6 +528,8 @@ void UTireflyActorPoolLibrary::ProcessPawnController(APawn* Pawn, bool bActivate
 
 void UTireflyActorPoolLibrary::GenericBeginPlay_Actor(const UObject* WorldContext, AActor* Actor)
 {
+	TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(GenericBeginPlay);
+
 	if (!IsValid(Actor))
 	{
 		return;
@@ -246,16 +539,13 @@ void UTireflyActorPoolLibrary::GenericBeginPlay_Actor(const UObject* WorldContex
 	Actor->SetActorEnableCollision(true);
 	Actor->SetActorHiddenInGame(false);
 
-	TInlineComponentArray<UActorComponent*> Components;
-	Actor->GetComponents(Components);
-	for (UActorComponent* Component : Components)
-	{
-		ProcessComponent(Component, true);
-	}
+	ProcessComponents(Actor, true);
 }
 
 void UTireflyActorPoolLibrary::GenericEndPlay_Actor(const UObject* WorldContext, AActor* Actor)
 {
+	TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(GenericEndPlay);
+
 	if (!IsValid(Actor))
 	{
 		return;
@@ -265,12 +555,7 @@ void UTireflyActorPoolLibrary::GenericEndPlay_Actor(const UObject* WorldContext,
 	Actor->SetActorEnableCollision(false);
 	Actor->SetActorHiddenInGame(true);
 
-	TInlineComponentArray<UActorComponent*> Components;
-	Actor->GetComponents(Components);
-	for (UActorComponent* Component : Components)
-	{
-		ProcessComponent(Component, false);
-	}
+	ProcessComponents(Actor, false);
 }
 
 void UTireflyActorPoolLibrary::GenericWarmUp_Actor(const UObject* WorldContext, AActor* Actor)
@@ -0,0 +1,101 @@
+// Copyright Tirefly. All Rights Reserved.
+
+
+#include "TireflyActorPoolManifest.h"
+
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "TireflyActorPoolLogChannels.h"
+#include "TireflyActorPoolSettings.h"
+
+
+
+FString FTireflyActorPoolManifest::GetManifestFilePath(const FString& MapPackageName)
+{
+	FString FileName = MapPackageName;
+	FileName.RemoveFromStart(TEXT("/"));
+	FileName.ReplaceCharInline(TEXT('/'), TEXT('_'));
+
+	const FString& Directory = GetDefault<UTireflyActorPoolSettings>()->UsageManifestDirectory;
+	return FPaths::Combine(FPaths::ProjectDir(), Directory, FileName + TEXT(".tapmanifest"));
+}
+
+bool FTireflyActorPoolManifest::LoadFromFile(const FString& FilePath)
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath) || Lines.IsEmpty())
+	{
+		return false;
+	}
+
+	TArray<FString> Fields;
+	Lines[0].ParseIntoArray(Fields, TEXT(","), false);
+	if (Fields.Num() != 2 || Fields[0] != TEXT("TireflyActorPoolManifest") || FCString::Atoi(*Fields[1]) != Version)
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Unsupported manifest header in %s"), *FString(__FUNCTION__), *FilePath);
+		return false;
+	}
+
+	Entries.Reset();
+	for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		Lines[LineIndex].ParseIntoArray(Fields, TEXT(","), false);
+		if (Fields.Num() == 2 && Fields[0] == TEXT("Map"))
+		{
+			MapPackageName = Fields[1];
+		}
+		else if (Fields.Num() == 6 && Fields[0] == TEXT("Pool"))
+		{
+			FTireflyActorPoolManifestEntry& Entry = Entries.AddDefaulted_GetRef();
+			Entry.ActorClass = FSoftClassPath(Fields[1]);
+			Entry.ActorId = FName(*Fields[2]);
+			Entry.PeakActiveCount = FCString::Atoi(*Fields[3]);
+			Entry.MissCount = FCString::Atoi(*Fields[4]);
+			Entry.FirstDemandTime = FCString::Atof(*Fields[5]);
+		}
+		else if (!Lines[LineIndex].IsEmpty())
+		{
+			UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Skipped malformed line %d in %s"), *FString(__FUNCTION__), LineIndex + 1, *FilePath);
+		}
+	}
+
+	return true;
+}
+
+bool FTireflyActorPoolManifest::SaveToFile(const FString& FilePath) const
+{
+	TStringBuilder<1024> Builder;
+	Builder.Appendf(TEXT("TireflyActorPoolManifest,%d\n"), Version);
+	Builder.Appendf(TEXT("Map,%s\n"), *MapPackageName);
+	for (const FTireflyActorPoolManifestEntry& Entry : Entries)
+	{
+		Builder.Appendf(TEXT("Pool,%s,%s,%d,%d,%.3f\n"),
+			*Entry.ActorClass.ToString(),
+			*Entry.ActorId.ToString(),
+			Entry.PeakActiveCount,
+			Entry.MissCount,
+			Entry.FirstDemandTime);
+	}
+
+	return FFileHelper::SaveStringToFile(Builder.ToView(), *FilePath);
+}
+
+void FTireflyActorPoolManifest::Merge(const FTireflyActorPoolManifest& Other)
+{
+	for (const FTireflyActorPoolManifestEntry& OtherEntry : Other.Entries)
+	{
+		FTireflyActorPoolManifestEntry* Entry = Entries.FindByPredicate([&OtherEntry](const FTireflyActorPoolManifestEntry& Existing)
+		{
+			return Existing.IsSamePool(OtherEntry);
+		});
+		if (!Entry)
+		{
+			Entries.Add(OtherEntry);
+			continue;
+		}
+
+		Entry->PeakActiveCount = FMath::Max(Entry->PeakActiveCount, OtherEntry.PeakActiveCount);
+		Entry->MissCount = FMath::Max(Entry->MissCount, OtherEntry.MissCount);
+		Entry->FirstDemandTime = FMath::Min(Entry->FirstDemandTime, OtherEntry.FirstDemandTime);
+	}
+}
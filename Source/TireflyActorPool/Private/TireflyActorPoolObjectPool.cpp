@@ -0,0 +1,448 @@
+// Copyright Tirefly. All Rights Reserved.
+
+
+#include "TireflyActorPoolWorldSubsystem.h"
+
+#include "Components/ActorComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "TireflyActorPoolLogChannels.h"
+#include "TireflyPoolingObjectDispatch.h"
+
+
+// UTireflyActorPoolWorldSubsystem中组件与UObject对象池的部分
+
+
+namespace TireflyActorPool
+{
+	// 把对象移到新的Outer下，组件的Owner随Outer一起改变；Outer没有变化时不做任何处理
+	static void MoveObjectToOuter(UObject* Object, UObject* NewOuter)
+	{
+		if (Object->GetOuter() == NewOuter)
+		{
+			return;
+		}
+
+		const FName NewName = MakeUniqueObjectName(NewOuter, Object->GetClass(), Object->GetClass()->GetFName());
+		Object->Rename(*NewName.ToString(), NewOuter, REN_DontCreateRedirectors | REN_NonTransactional | REN_DoNotDirty);
+	}
+}
+
+
+UActorComponent* UTireflyActorPoolWorldSubsystem::SpawnComponentFromPool(
+	TSubclassOf<UActorComponent> ComponentClass,
+	AActor* Owner,
+	const FTransform& RelativeTransform,
+	USceneComponent* AttachParent,
+	FName SocketName,
+	const FInstancedStruct* InitialData)
+{
+	if (!IsInGameThread())
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Must be called on the game thread"), *FString(__FUNCTION__));
+		return nullptr;
+	}
+
+	if (!IsValidObjectPoolClass(ComponentClass, *FString(__FUNCTION__)))
+	{
+		return nullptr;
+	}
+
+	if (!IsValid(Owner))
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid Owner"), *FString(__FUNCTION__));
+		return nullptr;
+	}
+
+	if (AttachParent && AttachParent->GetOwner() != Owner)
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] AttachParent %s does not belong to Owner %s, attaching to the root component instead"),
+			*FString(__FUNCTION__),
+			*AttachParent->GetName(),
+			*Owner->GetName());
+		AttachParent = nullptr;
+	}
+
+	FTireflyObjectPool& Pool = ObjectPoolOfClass.FindOrAdd(ComponentClass);
+	UActorComponent* Component = static_cast<UActorComponent*>(FetchObjectFromPool(Pool));
+	if (!Component)
+	{
+		Component = static_cast<UActorComponent*>(CreatePooledObject_Internal(ComponentClass));
+	}
+
+	// 组件的Owner就是它的Outer，待命组件在对象池的承载Actor名下，移到新的Owner名下后加入它的组件列表
+	TireflyActorPool::MoveObjectToOuter(Component, Owner);
+
+	if (USceneComponent* SceneComponent = Cast<USceneComponent>(Component))
+	{
+		// 注册之前设置挂接关系，注册时会一并完成挂接和Transform的更新
+		if (USceneComponent* Parent = AttachParent ? AttachParent : Owner->GetRootComponent())
+		{
+			SceneComponent->SetupAttachment(Parent, SocketName);
+		}
+		SceneComponent->SetRelativeTransform(RelativeTransform);
+	}
+
+	// 注册时自动激活的组件会被重新激活
+	Component->RegisterComponent();
+
+	if (FTireflyPoolingObjectDispatch::Implements(ComponentClass))
+	{
+		FTireflyPoolingObjectDispatch::PoolingBeginPlay(Component);
+		if (InitialData)
+		{
+			FTireflyPoolingObjectDispatch::PoolingInitialized(Component, *InitialData);
+		}
+	}
+
+	return Component;
+}
+
+UObject* UTireflyActorPoolWorldSubsystem::SpawnObjectFromPool(
+	TSubclassOf<UObject> ObjectClass,
+	UObject* Outer,
+	const FInstancedStruct* InitialData)
+{
+	if (!IsInGameThread())
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Must be called on the game thread"), *FString(__FUNCTION__));
+		return nullptr;
+	}
+
+	if (!IsValidObjectPoolClass(ObjectClass, *FString(__FUNCTION__)))
+	{
+		return nullptr;
+	}
+
+	if (ObjectClass->IsChildOf(UActorComponent::StaticClass()))
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] %s is a component class, use SpawnComponentFromPool instead"),
+			*FString(__FUNCTION__),
+			*ObjectClass->GetName());
+		return nullptr;
+	}
+
+	FTireflyObjectPool& Pool = ObjectPoolOfClass.FindOrAdd(ObjectClass);
+	UObject* Object = FetchObjectFromPool(Pool);
+	if (!Object)
+	{
+		Object = CreatePooledObject_Internal(ObjectClass);
+	}
+
+	if (Outer)
+	{
+		TireflyActorPool::MoveObjectToOuter(Object, Outer);
+	}
+
+	if (FTireflyPoolingObjectDispatch::Implements(ObjectClass))
+	{
+		FTireflyPoolingObjectDispatch::PoolingBeginPlay(Object);
+		if (InitialData)
+		{
+			FTireflyPoolingObjectDispatch::PoolingInitialized(Object, *InitialData);
+		}
+	}
+
+	return Object;
+}
+
+void UTireflyActorPoolWorldSubsystem::RecycleObjectToPool(UObject* Object)
+{
+	if (!IsInGameThread())
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Must be called on the game thread"), *FString(__FUNCTION__));
+		return;
+	}
+
+	if (!IsValid(Object))
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Invalid Object"), *FString(__FUNCTION__));
+		return;
+	}
+
+	if (!IsValidObjectPoolClass(Object->GetClass(), *FString(__FUNCTION__)))
+	{
+		return;
+	}
+
+	if (FTireflyPoolingObjectDispatch::Implements(Object->GetClass()))
+	{
+		FTireflyPoolingObjectDispatch::PoolingEndPlay(Object);
+	}
+
+	FTireflyObjectPool& Pool = ObjectPoolOfClass.FindOrAdd(Object->GetClass());
+	Pool.ActiveCount = FMath::Max(Pool.ActiveCount - 1, 0);
+	++Pool.RecycleCount;
+
+	UActorComponent* Component = Cast<UActorComponent>(Object);
+	if (Component)
+	{
+		Component->Deactivate();
+		if (USceneComponent* SceneComponent = Cast<USceneComponent>(Component))
+		{
+			SceneComponent->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
+		}
+		if (Component->IsRegistered())
+		{
+			Component->UnregisterComponent();
+		}
+	}
+
+	if (Pool.Policy.MaxIdleCount > 0 && Pool.ObjectPool.Num() >= Pool.Policy.MaxIdleCount)
+	{
+		// 对象池已满，超出容量的对象直接销毁，避免对象池只增不减
+		DestroyIdleObject(Object);
+		return;
+	}
+
+	// 待命的组件移到承载Actor名下，离开原Owner的组件列表，GetComponents和原Owner的激活、冷待命处理都不会再看到它，
+	// 原Owner被销毁时也不会连带销毁它
+	if (Component)
+	{
+		AActor* HostActor = FindOrCreateIdleComponentHost();
+		if (!HostActor)
+		{
+			DestroyIdleObject(Component);
+			return;
+		}
+
+		TireflyActorPool::MoveObjectToOuter(Component, HostActor);
+	}
+
+	Pool.PushIdleObject(Object, GetPoolTime());
+}
+
+void UTireflyActorPoolWorldSubsystem::WarmUpObjectPool(TSubclassOf<UObject> ObjectClass, int32 Count)
+{
+	if (!IsValidObjectPoolClass(ObjectClass, *FString(__FUNCTION__)))
+	{
+		return;
+	}
+
+	if (Count <= 0)
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Count must be greater than 0"), *FString(__FUNCTION__));
+		return;
+	}
+
+	FTireflyObjectPool& Pool = ObjectPoolOfClass.FindOrAdd(ObjectClass);
+	if (Pool.Policy.MaxIdleCount > 0)
+	{
+		Count = FMath::Min(Count, Pool.Policy.MaxIdleCount - Pool.ObjectPool.Num());
+		if (Count <= 0)
+		{
+			return;
+		}
+	}
+
+	const bool bImplementsInterface = FTireflyPoolingObjectDispatch::Implements(ObjectClass);
+	TArray<UObject*> WarmUpObjects;
+	WarmUpObjects.Reserve(Count);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		UObject* Object = CreatePooledObject_Internal(ObjectClass);
+		if (bImplementsInterface)
+		{
+			FTireflyPoolingObjectDispatch::PoolingWarmUp(Object);
+		}
+		WarmUpObjects.Add(Object);
+	}
+
+	// 预热处理中可能有新的对象池被加入，需要重新查找对象池
+	FTireflyObjectPool& WarmUpPool = ObjectPoolOfClass.FindOrAdd(ObjectClass);
+	const double CurrentTime = GetPoolTime();
+	for (UObject* Object : WarmUpObjects)
+	{
+		WarmUpPool.PushIdleObject(Object, CurrentTime);
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::ClearAllObjectPools()
+{
+	for (auto& Pool : ObjectPoolOfClass)
+	{
+		for (UObject* Object : Pool.Value.ObjectPool)
+		{
+			DestroyIdleObject(Object);
+		}
+	}
+
+	ObjectPoolOfClass.Empty();
+
+	if (IsValid(IdleComponentHostActor))
+	{
+		IdleComponentHostActor->Destroy(true);
+	}
+	IdleComponentHostActor = nullptr;
+}
+
+void UTireflyActorPoolWorldSubsystem::ClearObjectPoolOfClass(TSubclassOf<UObject> ObjectClass)
+{
+	FTireflyObjectPool Pool;
+	if (ObjectPoolOfClass.RemoveAndCopyValue(ObjectClass, Pool))
+	{
+		for (UObject* Object : Pool.ObjectPool)
+		{
+			DestroyIdleObject(Object);
+		}
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::SetObjectPoolPolicyOfClass(TSubclassOf<UObject> ObjectClass, const FTireflyActorPoolPolicy& Policy)
+{
+	if (!IsValidObjectPoolClass(ObjectClass, *FString(__FUNCTION__)))
+	{
+		return;
+	}
+
+	FTireflyObjectPool& Pool = ObjectPoolOfClass.FindOrAdd(ObjectClass);
+	Pool.Policy = Policy;
+	EnforceObjectPoolCapacity(Pool);
+}
+
+FTireflyActorPoolPolicy UTireflyActorPoolWorldSubsystem::GetObjectPoolPolicyOfClass(TSubclassOf<UObject> ObjectClass) const
+{
+	const FTireflyObjectPool* Pool = ObjectPoolOfClass.Find(ObjectClass);
+	return Pool ? Pool->Policy : FTireflyActorPoolPolicy();
+}
+
+bool UTireflyActorPoolWorldSubsystem::IsValidObjectPoolClass(const UClass* ObjectClass, const TCHAR* FunctionName)
+{
+	if (!IsValid(ObjectClass))
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Invalid ObjectClass"), FunctionName);
+		return false;
+	}
+
+	if (ObjectClass->IsChildOf(AActor::StaticClass()))
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] %s is an actor class, use the actor pool instead"), FunctionName, *ObjectClass->GetName());
+		return false;
+	}
+
+	if (ObjectClass->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists))
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] %s cannot be instantiated"), FunctionName, *ObjectClass->GetName());
+		return false;
+	}
+
+	return true;
+}
+
+UObject* UTireflyActorPoolWorldSubsystem::FetchObjectFromPool(FTireflyObjectPool& Pool)
+{
+	UObject* Object = nullptr;
+	while (!Pool.ObjectPool.IsEmpty() && !Object)
+	{
+		// 待命对象可能被外部强制销毁，跳过失效的对象
+		UObject* IdleObject = Pool.PopIdleObject();
+		Object = IsValid(IdleObject) ? IdleObject : nullptr;
+	}
+
+	++Pool.ActiveCount;
+	Pool.PeakActiveCount = FMath::Max(Pool.PeakActiveCount, Pool.ActiveCount);
+	if (Object)
+	{
+		++Pool.HitCount;
+	}
+	else
+	{
+		++Pool.MissCount;
+	}
+
+	return Object;
+}
+
+UObject* UTireflyActorPoolWorldSubsystem::CreatePooledObject_Internal(const TSubclassOf<UObject>& ObjectClass)
+{
+	UObject* Object = NewObject<UObject>(this, ObjectClass, NAME_None, RF_Transient);
+	++ObjectPoolOfClass.FindOrAdd(ObjectClass).ColdSpawnCount;
+
+	return Object;
+}
+
+void UTireflyActorPoolWorldSubsystem::EnforceObjectPoolCapacity(FTireflyObjectPool& Pool)
+{
+	const int32 ExcessNum = Pool.Policy.MaxIdleCount > 0 ? Pool.ObjectPool.Num() - Pool.Policy.MaxIdleCount : 0;
+	if (ExcessNum <= 0)
+	{
+		return;
+	}
+
+	for (int32 Index = 0; Index < ExcessNum; ++Index)
+	{
+		DestroyIdleObject(Pool.ObjectPool[Index]);
+	}
+	Pool.RemoveIdleObjectsFromBottom(ExcessNum);
+}
+
+void UTireflyActorPoolWorldSubsystem::TrimObjectPool(FTireflyObjectPool& Pool, double CurrentTime)
+{
+	const FTireflyActorPoolPolicy& Policy = Pool.Policy;
+	if (Policy.IdleTimeout <= 0.f)
+	{
+		return;
+	}
+
+	const int32 SurplusNum = Pool.ObjectPool.Num() - FMath::Max(Policy.MinIdleCount, 0);
+	const int32 MaxTrimNum = FMath::Min(SurplusNum, FMath::Max(Policy.MaxTrimPerFrame, 1));
+
+	// 对象池头部的对象闲置最久，只需从头部开始检查
+	int32 TrimNum = 0;
+	while (TrimNum < MaxTrimNum && Pool.IdleSinceTimes[TrimNum] + Policy.IdleTimeout <= CurrentTime)
+	{
+		DestroyIdleObject(Pool.ObjectPool[TrimNum]);
+		++TrimNum;
+	}
+
+	if (TrimNum > 0)
+	{
+		Pool.RemoveIdleObjectsFromBottom(TrimNum);
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::DestroyIdleObject(UObject* Object)
+{
+	if (!IsValid(Object))
+	{
+		return;
+	}
+
+	if (UActorComponent* Component = Cast<UActorComponent>(Object))
+	{
+		Component->DestroyComponent();
+	}
+	else
+	{
+		// 对象可能仍被外部引用，标记为垃圾后外部的引用会失效，不会继续使用已经离开对象池的对象
+		Object->MarkAsGarbage();
+	}
+}
+
+AActor* UTireflyActorPoolWorldSubsystem::FindOrCreateIdleComponentHost()
+{
+	if (IsValid(IdleComponentHostActor))
+	{
+		return IdleComponentHostActor;
+	}
+
+	UWorld* World = GetWorld();
+	if (!IsValid(World) || World->bIsTearingDown)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.ObjectFlags |= RF_Transient;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	IdleComponentHostActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+	if (!IsValid(IdleComponentHostActor))
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Failed to spawn the idle component host actor"), *FString(__FUNCTION__));
+		IdleComponentHostActor = nullptr;
+		return nullptr;
+	}
+
+	return IdleComponentHostActor;
+}
@@ -0,0 +1,68 @@
+// Copyright Tirefly. All Rights Reserved.
+
+
+#include "TireflyActorPoolStats.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "TireflyActorPoolWorldSubsystem.h"
+
+
+
+DEFINE_STAT(STAT_TireflyActorPool_SpawnActor);
+DEFINE_STAT(STAT_TireflyActorPool_SpawnActors);
+DEFINE_STAT(STAT_TireflyActorPool_RecycleActor);
+DEFINE_STAT(STAT_TireflyActorPool_RecycleAllActiveActors);
+DEFINE_STAT(STAT_TireflyActorPool_WarmUpActorPool);
+DEFINE_STAT(STAT_TireflyActorPool_TickWarmUpQueue);
+DEFINE_STAT(STAT_TireflyActorPool_TickPendingCommands);
+DEFINE_STAT(STAT_TireflyActorPool_TickActorLifetimes);
+DEFINE_STAT(STAT_TireflyActorPool_TickActorPoolTiering);
+DEFINE_STAT(STAT_TireflyActorPool_TickActorPoolProxies);
+DEFINE_STAT(STAT_TireflyActorPool_TickDeferredSpawnQueue);
+DEFINE_STAT(STAT_TireflyActorPool_GenericBeginPlay);
+DEFINE_STAT(STAT_TireflyActorPool_GenericEndPlay);
+
+DEFINE_STAT(STAT_TireflyActorPool_Hits);
+DEFINE_STAT(STAT_TireflyActorPool_Misses);
+DEFINE_STAT(STAT_TireflyActorPool_ColdSpawns);
+DEFINE_STAT(STAT_TireflyActorPool_Recycles);
+DEFINE_STAT(STAT_TireflyActorPool_Freezes);
+DEFINE_STAT(STAT_TireflyActorPool_Thaws);
+DEFINE_STAT(STAT_TireflyActorPool_Dehydrations);
+DEFINE_STAT(STAT_TireflyActorPool_Hydrations);
+DEFINE_STAT(STAT_TireflyActorPool_DeferredSpawns);
+DEFINE_STAT(STAT_TireflyActorPool_DroppedSpawns);
+DEFINE_STAT(STAT_TireflyActorPool_IdleActors);
+DEFINE_STAT(STAT_TireflyActorPool_ActiveActors);
+
+CSV_DEFINE_CATEGORY_MODULE(TIREFLYACTORPOOL_API, TireflyActorPool, true);
+
+UE_TRACE_CHANNEL_DEFINE(TireflyActorPoolChannel);
+
+
+
+namespace TireflyActorPool
+{
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpCommand(
+		TEXT("TireflyActorPool.Dump"),
+		TEXT("输出当前世界中每个对象池的待命、激活、命中、未命中、即时生成和回收统计"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+		{
+			if (const UTireflyActorPoolWorldSubsystem* SubsystemAP = World ? World->GetSubsystem<UTireflyActorPoolWorldSubsystem>() : nullptr)
+			{
+				SubsystemAP->DumpActorPoolStats(Ar);
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice ResetStatsCommand(
+		TEXT("TireflyActorPool.ResetStats"),
+		TEXT("清零当前世界中每个对象池的命中、未命中、即时生成和回收统计"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+		{
+			if (UTireflyActorPoolWorldSubsystem* SubsystemAP = World ? World->GetSubsystem<UTireflyActorPoolWorldSubsystem>() : nullptr)
+			{
+				SubsystemAP->ResetActorPoolStats();
+			}
+		}));
+}
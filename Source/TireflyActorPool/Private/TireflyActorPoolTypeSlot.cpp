@@ -0,0 +1,14 @@
+// Copyright Tirefly. All Rights Reserved.
+
+
+#include "TireflyActorPoolTypeSlot.h"
+
+#include <atomic>
+
+
+
+int32 FTireflyActorPoolTypeSlots::Allocate()
+{
+	static std::atomic<int32> NextSlot{ 0 };
+	return NextSlot.fetch_add(1, std::memory_order_relaxed);
+}
@@ -3,281 +3,3308 @@
 
 #include "TireflyActorPoolWorldSubsystem.h"
 
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SceneComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LevelStreaming.h"
 #include "Engine/World.h"
-#include "TimerManager.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameMapsSettings.h"
+#include "Misc/OutputDevice.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "TireflyActorPoolConfig.h"
+#include "TireflyActorPoolGameInstanceSubsystem.h"
 #include "TireflyActorPoolLogChannels.h"
+#include "TireflyActorPoolManifest.h"
+#include "TireflyActorPoolSettings.h"
+#include "TireflyActorPoolStats.h"
+#include "TireflyPoolingActorDispatch.h"
 #include "TireflyPoolingActorInterface.h"
+#include "WorldPartition/DataLayer/DataLayerAsset.h"
+#include "WorldPartition/DataLayer/DataLayerInstance.h"
+#include "WorldPartition/DataLayer/DataLayerManager.h"
+
+
+namespace TireflyActorPool
+{
+	// 对象池需求移动平均的时间常数（秒）
+	constexpr float DemandAverageTimeConstant = 2.f;
+
+	// 移除代理和它的实例，代理组件开启了bSupportRemoveAtSwap，实例与代理记录以相同的方式填补空位
+	static void RemoveProxy(FTireflyActorPool& Pool, int32 ProxyIndex)
+	{
+		Pool.Proxies.RemoveAtSwap(ProxyIndex, 1, EAllowShrinking::No);
+		if (IsValid(Pool.ProxyComponent))
+		{
+			Pool.ProxyComponent->RemoveInstance(ProxyIndex);
+		}
+	}
+
+	// 从对象池头部移出Count个待命Actor后再销毁，销毁回调不会修改正在遍历的对象池
+	static void DestroyIdleActorsFromBottom(FTireflyActorPool& Pool, int32 Count)
+	{
+		TArray<AActor*, TInlineAllocator<16>> IdleActors(Pool.ActorPool.GetData(), Count);
+		Pool.RemoveIdleActorsFromBottom(Count);
+		for (AActor* Actor : IdleActors)
+		{
+			if (IsValid(Actor))
+			{
+				Actor->Destroy();
+			}
+		}
+	}
+
+	// 重新注册冷待命之前已经注册的组件，场景组件的挂接父组件同样在集合中时先注册父组件
+	static void RegisterFrozenComponent(const AActor* Actor, UActorComponent* Component, const TArray<TWeakObjectPtr<UActorComponent>>& FrozenComponents)
+	{
+		// 冷待命期间组件可能已经被销毁或移到其他Actor名下
+		if (!IsValid(Component) || Component->IsRegistered() || Component->GetOwner() != Actor)
+		{
+			return;
+		}
+
+		if (const USceneComponent* SceneComponent = Cast<USceneComponent>(Component))
+		{
+			USceneComponent* AttachParent = SceneComponent->GetAttachParent();
+			if (AttachParent && FrozenComponents.Contains(AttachParent))
+			{
+				RegisterFrozenComponent(Actor, AttachParent, FrozenComponents);
+			}
+		}
+
+		Component->RegisterComponent();
+	}
+
+	// 移出对象池中的所有待命Actor后再销毁
+	static void DestroyAllIdleActors(FTireflyActorPool& Pool)
+	{
+		TArray<AActor*> IdleActors = MoveTemp(Pool.ActorPool);
+		Pool.Empty();
+		for (AActor* Actor : IdleActors)
+		{
+			if (IsValid(Actor))
+			{
+				Actor->Destroy(true);
+			}
+		}
+	}
+
+	// 把延迟生成请求插入到第一个优先级更低的请求之前，相同优先级的请求保持提交顺序
+	static void InsertDeferredSpawn(TArray<FTireflyActorPoolDeferredSpawn>& Queue, FTireflyActorPoolDeferredSpawn&& Request)
+	{
+		const int32 Priority = Request.Priority;
+		const int32 InsertIndex = Queue.IndexOfByPredicate([Priority](const FTireflyActorPoolDeferredSpawn& Other)
+		{
+			return Other.Priority < Priority;
+		});
+		Queue.Insert(MoveTemp(Request), InsertIndex == INDEX_NONE ? Queue.Num() : InsertIndex);
+	}
+}
+
+TRACE_DECLARE_INT_COUNTER(TireflyActorPool_IdleActors, TEXT("TireflyActorPool/IdleActors"));
+TRACE_DECLARE_INT_COUNTER(TireflyActorPool_ActiveActors, TEXT("TireflyActorPool/ActiveActors"));
 
 
 void UTireflyActorPoolWorldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
+
+	const UTireflyActorPoolSettings* Settings = GetDefault<UTireflyActorPoolSettings>();
+	WarmUpFrameBudgetMs = Settings->WarmUpFrameBudgetMs;
+	ColdSpawnFrameBudgetCount = Settings->ColdSpawnFrameBudgetCount;
+	ColdSpawnFrameBudgetMs = Settings->ColdSpawnFrameBudgetMs;
+	DeferredSpawnDropTimeout = Settings->DeferredSpawnDropTimeout;
+}
+
+void UTireflyActorPoolWorldSubsystem::Deinitialize()
+{
+	if (bRecordingUsageManifest)
+	{
+		SaveActorPoolUsageManifest();
+		bRecordingUsageManifest = false;
+	}
+
+	StashPersistentActorPools();
+	ClearAllActorPools();
+	ClearAllObjectPools();
+	LifetimeWheel.Empty();
+	WarmUpQueue.Empty();
+	DeferredSpawnQueue.Empty();
+	ActorPoolReservations.Empty();
+	ReservedStreamingLevels.Empty();
+	PendingCommands.Empty();
+	DrainedCommands.Empty();
+	PooledActorRecords.Empty();
+
+	for (auto& LoadHandle : ActorClassLoadHandles)
+	{
+		if (!LoadHandle.Value.IsValid())
+		{
+			continue;
+		}
+
+		if (LoadHandle.Value->IsLoadingInProgress())
+		{
+			LoadHandle.Value->CancelHandle();
+		}
+		else
+		{
+			LoadHandle.Value->ReleaseHandle();
+		}
+	}
+	ActorClassLoadHandles.Empty();
+
+	if (ReservationConfigsHandle.IsValid())
+	{
+		if (ReservationConfigsHandle->IsLoadingInProgress())
+		{
+			ReservationConfigsHandle->CancelHandle();
+		}
+		else
+		{
+			ReservationConfigsHandle->ReleaseHandle();
+		}
+		ReservationConfigsHandle.Reset();
+	}
+
+	if (WorldPoolConfigsHandle.IsValid())
+	{
+		if (WorldPoolConfigsHandle->IsLoadingInProgress())
+		{
+			WorldPoolConfigsHandle->CancelHandle();
+		}
+		else
+		{
+			WorldPoolConfigsHandle->ReleaseHandle();
+		}
+		WorldPoolConfigsHandle.Reset();
+	}
+	WorldPoolConfigs.Empty();
+
+	if (UDataLayerManager* DataLayerManager = UDataLayerManager::GetDataLayerManager(GetWorld()))
+	{
+		DataLayerManager->OnDataLayerInstanceRuntimeStateChanged.RemoveDynamic(this, &UTireflyActorPoolWorldSubsystem::HandleDataLayerRuntimeStateChanged);
+	}
+
+	Super::Deinitialize();
+}
+
+void UTireflyActorPoolWorldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	const UTireflyActorPoolSettings* Settings = GetDefault<UTireflyActorPoolSettings>();
+
+#if !UE_BUILD_SHIPPING
+	bRecordingUsageManifest = Settings->bRecordUsageManifest;
+#endif
+
+	// 持久对象池先于配置和清单预热，它们只补足还缺少的部分
+	RestorePersistentActorPools();
+
+	// 使用情况清单只补足对象池配置没有预热的部分，需要在配置加载并应用之后再应用
+	if (Settings->bApplyPoolConfigOnWorldBeginPlay)
+	{
+		LoadWorldPoolConfigs(InWorld);
+	}
+	else if (Settings->bApplyUsageManifest)
+	{
+		ApplyActorPoolUsageManifest(InWorld);
+	}
+
+	// PIE中流送关卡的包名带有与所在世界相同的前缀
+	const int32 PIEInstanceID = InWorld.GetOutermost()->GetPIEInstanceID();
+	StreamingLevelPoolConfigs.Reset();
+	for (const auto& LevelConfig : Settings->StreamingLevelPoolConfigs)
+	{
+		FString PackageName = LevelConfig.Key.ToSoftObjectPath().GetLongPackageName();
+		if (PIEInstanceID != INDEX_NONE)
+		{
+			PackageName = UWorld::ConvertToPIEPackageName(PackageName, PIEInstanceID);
+		}
+		StreamingLevelPoolConfigs.Add(FName(PackageName), LevelConfig.Value);
+	}
+
+	LoadReservationConfigs();
+	BindDataLayerReservations(InWorld);
+}
+
+void UTireflyActorPoolWorldSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// 即时生成预算按子系统的Tick划分帧
+	ColdSpawnsThisFrame = 0;
+	ColdSpawnSecondsThisFrame = 0.0;
+
+	TickPendingCommands();
+	TickActorLifetimes();
+	TickDeferredSpawnQueue();
+	TickActorPoolProxies();
+	TickStreamingLevelReservations();
+	TickActorPoolTrimming();
+	TickActorPoolTiering();
+	TickActorPoolReplenishment(DeltaTime);
+	TickWarmUpQueue();
+	TickActorPoolStats();
+}
+
+TStatId UTireflyActorPoolWorldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTireflyActorPoolWorldSubsystem, STATGROUP_TireflyActorPool);
+}
+
+void UTireflyActorPoolWorldSubsystem::EnqueueSpawnActorFromPool(
+	TSubclassOf<AActor> ActorClass,
+	FName ActorId,
+	const FTransform& Transform,
+	FInstancedStruct InitialData,
+	float Lifetime,
+	const ESpawnActorCollisionHandlingMethod CollisionHandling,
+	AActor* Owner,
+	APawn* Instigator,
+	TFunction<void(AActor*)>&& OnSpawned)
+{
+	FTireflyActorPoolCommand Command;
+	Command.Type = FTireflyActorPoolCommand::EType::Spawn;
+	Command.ActorClass = ActorClass.Get();
+	Command.ActorId = ActorId;
+	Command.Transform = Transform;
+	Command.InitialData = MoveTemp(InitialData);
+	Command.Lifetime = Lifetime;
+	Command.CollisionHandling = CollisionHandling;
+	Command.Owner = Owner;
+	Command.Instigator = Instigator;
+	Command.OnSpawned = MoveTemp(OnSpawned);
+
+	PendingCommands.Enqueue(MoveTemp(Command));
+}
+
+void UTireflyActorPoolWorldSubsystem::EnqueueRecycleActorToPool(AActor* Actor)
+{
+	FTireflyActorPoolCommand Command;
+	Command.Type = FTireflyActorPoolCommand::EType::Recycle;
+	Command.Actor = Actor;
+
+	PendingCommands.Enqueue(MoveTemp(Command));
+}
+
+void UTireflyActorPoolWorldSubsystem::TickPendingCommands()
+{
+	// 先取出本帧已有的全部命令再执行，执行过程中新提交的命令留到下一帧
+	FTireflyActorPoolCommand Command;
+	while (PendingCommands.Dequeue(Command))
+	{
+		DrainedCommands.Add(MoveTemp(Command));
+	}
+
+	if (DrainedCommands.IsEmpty())
+	{
+		return;
+	}
+
+	TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(TickPendingCommands);
+
+	for (FTireflyActorPoolCommand& DrainedCommand : DrainedCommands)
+	{
+		ExecuteCommand(DrainedCommand);
+	}
+	DrainedCommands.Reset();
+}
+
+void UTireflyActorPoolWorldSubsystem::ExecuteCommand(FTireflyActorPoolCommand& Command)
+{
+	switch (Command.Type)
+	{
+	case FTireflyActorPoolCommand::EType::Spawn:
+		{
+			AActor* Actor = SpawnActor_Internal(
+				Command.ActorClass.Get(),
+				Command.ActorId,
+				Command.Transform,
+				Command.InitialData.IsValid() ? &Command.InitialData : nullptr,
+				Command.Lifetime,
+				Command.CollisionHandling,
+				Command.Owner.Get(),
+				Command.Instigator.Get());
+			if (Command.OnSpawned)
+			{
+				Command.OnSpawned(Actor);
+			}
+			break;
+		}
+	case FTireflyActorPoolCommand::EType::Recycle:
+		{
+			if (AActor* Actor = Command.Actor.Get())
+			{
+				RecycleActorToPool(Actor);
+			}
+			break;
+		}
+	}
+}
+
+FTireflyActorPoolKey UTireflyActorPoolWorldSubsystem::FindOrCreatePool(TSubclassOf<AActor> ActorClass, FName ActorId)
+{
+	if (!IsValid(ActorClass))
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Invalid ActorClass"), *FString(__FUNCTION__));
+		return FTireflyActorPoolKey();
+	}
+
+	if (!FTireflyPoolingActorDispatch::Implements(ActorClass))
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] ActorClass %s does not implement UTireflyPoolingActorInterface"),
+			*FString(__FUNCTION__),
+			*ActorClass->GetName());
+		return FTireflyActorPoolKey();
+	}
+
+	return MakeActorPoolKey(FindOrAddActorPoolIndex(ActorClass, ActorId));
+}
+
+FTireflyActorPoolKey UTireflyActorPoolWorldSubsystem::GetHomeActorPool(const AActor* Actor) const
+{
+	const FTireflyPooledActorRecord* Record = PooledActorRecords.Find(Actor);
+	if (!Record || ResolveActorPoolIndex(Record->HomePool) == INDEX_NONE)
+	{
+		return FTireflyActorPoolKey();
+	}
+
+	return Record->HomePool;
+}
+
+AActor* UTireflyActorPoolWorldSubsystem::SpawnActorFromPoolKey_Internal(
+	const FTireflyActorPoolKey& PoolKey,
+	const FTransform& Transform,
+	const FTireflyPoolingInitialDataRef& InitialData,
+	float Lifetime,
+	const ESpawnActorCollisionHandlingMethod CollisionHandling,
+	AActor* Owner,
+	APawn* Instigator)
+{
+	TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(SpawnActor);
+
+	if (!IsInGameThread())
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Must be called on the game thread, use EnqueueSpawnActorFromPool from other threads"), *FString(__FUNCTION__));
+		return nullptr;
+	}
+
+	UWorld* World = GetWorld();
+	if (!IsValid(World))
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid World"), *FString(__FUNCTION__));
+		return nullptr;
+	}
+
+	const int32 PoolIndex = ResolveActorPoolIndex(PoolKey);
+	if (PoolIndex == INDEX_NONE)
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid or expired PoolKey"), *FString(__FUNCTION__));
+		return nullptr;
+	}
+
+	// Actor类型在创建句柄时已经校验过，这里不再查找对象池
+	const FTireflyActorPool& Pool = ActorPools[PoolIndex];
+	return SpawnActorFromPoolIndex_Internal(World, Pool.ActorClass, Pool.ActorId, PoolIndex, Transform, InitialData, Lifetime, CollisionHandling, Owner, Instigator);
+}
+
+void UTireflyActorPoolWorldSubsystem::ClearAllActorPools()
+{
+	for (auto& Pool : ActorPools)
+	{
+		TireflyActorPool::DestroyAllIdleActors(Pool);
+		ClearActorPoolProxies(Pool);
+	}
+
+	if (IsValid(ProxyHostActor))
+	{
+		ProxyHostActor->Destroy(true);
+	}
+	ProxyHostActor = nullptr;
+
+	ActorPools.Empty();
+	ActorPoolIndexOfClass.Empty();
+	ActorPoolIndexOfId.Empty();
+	FreeActorPoolIndices.Empty();
+	TypedActorPoolIndices.Empty();
+}
+
+void UTireflyActorPoolWorldSubsystem::ClearActorPoolsOfClass(TSubclassOf<AActor> ActorClass)
+{
+	int32 PoolIndex = INDEX_NONE;
+	if (ActorPoolIndexOfClass.RemoveAndCopyValue(ActorClass, PoolIndex))
+	{
+		ReleaseActorPool(PoolIndex);
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::ClearActorPoolOfId(FName ActorId)
+{
+	int32 PoolIndex = INDEX_NONE;
+	if (ActorPoolIndexOfId.RemoveAndCopyValue(ActorId, PoolIndex))
+	{
+		ReleaseActorPool(PoolIndex);
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::ReleaseActorPool(int32 PoolIndex)
+{
+	FTireflyActorPool& Pool = ActorPools[PoolIndex];
+	TireflyActorPool::DestroyAllIdleActors(Pool);
+	ClearActorPoolProxies(Pool);
+
+	// 重置为空的对象池而不是移除，保证其他对象池的索引不变
+	ActorPools[PoolIndex] = FTireflyActorPool();
+	FreeActorPoolIndices.Add(PoolIndex);
+
+	for (int32& TypedPoolIndex : TypedActorPoolIndices)
+	{
+		if (TypedPoolIndex == PoolIndex)
+		{
+			TypedPoolIndex = INDEX_NONE;
+		}
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::SetActorPoolPolicyOfClass(TSubclassOf<AActor> ActorClass, const FTireflyActorPoolPolicy& Policy)
+{
+	if (!IsValid(ActorClass))
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Invalid ActorClass"), *FString(__FUNCTION__));
+		return;
+	}
+
+	FTireflyActorPool& Pool = FindOrAddActorPool(ActorClass, NAME_None);
+	Pool.Policy = Policy;
+	Pool.bProxyUnavailable = false;
+	EnforceActorPoolCapacity(Pool);
+}
+
+void UTireflyActorPoolWorldSubsystem::SetActorPoolPolicyOfId(FName ActorId, const FTireflyActorPoolPolicy& Policy)
+{
+	if (ActorId == NAME_None)
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Invalid ActorId"), *FString(__FUNCTION__));
+		return;
+	}
+
+	FTireflyActorPool& Pool = FindOrAddActorPool(nullptr, ActorId);
+	Pool.Policy = Policy;
+	Pool.bProxyUnavailable = false;
+	EnforceActorPoolCapacity(Pool);
+}
+
+FTireflyActorPoolPolicy UTireflyActorPoolWorldSubsystem::GetActorPoolPolicyOfClass(TSubclassOf<AActor> ActorClass) const
+{
+	const FTireflyActorPool* Pool = FindActorPool(ActorClass, NAME_None);
+	return Pool ? Pool->Policy : FTireflyActorPoolPolicy();
+}
+
+FTireflyActorPoolPolicy UTireflyActorPoolWorldSubsystem::GetActorPoolPolicyOfId(FName ActorId) const
+{
+	const FTireflyActorPool* Pool = ActorId != NAME_None ? FindActorPool(nullptr, ActorId) : nullptr;
+	return Pool ? Pool->Policy : FTireflyActorPoolPolicy();
+}
+
+void UTireflyActorPoolWorldSubsystem::EnforceActorPoolCapacity(FTireflyActorPool& Pool)
+{
+	const int32 ExcessNum = Pool.Policy.MaxIdleCount > 0 ? Pool.ActorPool.Num() - Pool.Policy.MaxIdleCount : 0;
+	if (ExcessNum <= 0)
+	{
+		return;
+	}
+
+	TireflyActorPool::DestroyIdleActorsFromBottom(Pool, ExcessNum);
 }
 
-void UTireflyActorPoolWorldSubsystem::Deinitialize()
-{
-	ClearAllActorPools();
+void UTireflyActorPoolWorldSubsystem::TickActorPoolTrimming()
+{
+	const double CurrentTime = GetPoolTime();
+
+	for (const auto& PoolEntry : ActorPoolIndexOfClass)
+	{
+		TrimActorPool(ActorPools[PoolEntry.Value], CurrentTime);
+	}
+
+	for (const auto& PoolEntry : ActorPoolIndexOfId)
+	{
+		TrimActorPool(ActorPools[PoolEntry.Value], CurrentTime);
+	}
+
+	for (auto& PoolEntry : ObjectPoolOfClass)
+	{
+		TrimObjectPool(PoolEntry.Value, CurrentTime);
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::TrimActorPool(FTireflyActorPool& Pool, double CurrentTime)
+{
+	const FTireflyActorPoolPolicy& Policy = Pool.Policy;
+	const int32 KeepNum = FMath::Max(Policy.MinIdleCount, Pool.ReservedCount);
+	int32 TrimBudget = FMath::Max(Policy.MaxTrimPerFrame, 1);
+
+	// 保留被释放后，逐帧销毁不再需要的待命Actor，仍被其他内容保留的部分不会被销毁
+	if (Pool.PendingReleaseCount > 0)
+	{
+		const int32 ReleaseNum = FMath::Min3(Pool.PendingReleaseCount, Pool.ActorPool.Num() - KeepNum, TrimBudget);
+		if (ReleaseNum > 0)
+		{
+			TireflyActorPool::DestroyIdleActorsFromBottom(Pool, ReleaseNum);
+			Pool.PendingReleaseCount -= ReleaseNum;
+			TrimBudget -= ReleaseNum;
+		}
+	}
+
+	if (Policy.IdleTimeout <= 0.f)
+	{
+		return;
+	}
+
+	const int32 SurplusNum = Pool.ActorPool.Num() - KeepNum;
+	const int32 MaxTrimNum = FMath::Min(SurplusNum, TrimBudget);
+
+	// 对象池头部的Actor闲置最久，只需从头部开始检查
+	int32 TrimNum = 0;
+	while (TrimNum < MaxTrimNum && Pool.IdleSinceTimes[TrimNum] + Policy.IdleTimeout <= CurrentTime)
+	{
+		++TrimNum;
+	}
+
+	if (TrimNum > 0)
+	{
+		TireflyActorPool::DestroyIdleActorsFromBottom(Pool, TrimNum);
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::TickActorPoolTiering()
+{
+	TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(TickActorPoolTiering);
+
+	const double CurrentTime = GetPoolTime();
+
+	for (const auto& PoolEntry : ActorPoolIndexOfClass)
+	{
+		TierActorPool(ActorPools[PoolEntry.Value], CurrentTime);
+	}
+
+	for (const auto& PoolEntry : ActorPoolIndexOfId)
+	{
+		TierActorPool(ActorPools[PoolEntry.Value], CurrentTime);
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::TierActorPool(FTireflyActorPool& Pool, double CurrentTime)
+{
+	const FTireflyActorPoolPolicy& Policy = Pool.Policy;
+	int32 ChangeBudget = FMath::Max(Policy.MaxTierChangesPerFrame, 1);
+
+	// 热待命Actor位于冷待命Actor之后，闲置最久的热待命Actor就是冷待命前缀之后的第一个
+	const int32 MinHotNum = FMath::Max(Policy.MinHotIdleCount, 0);
+	while (ChangeBudget > 0 && Pool.GetNumHotIdle() > 0)
+	{
+		const int32 HotNum = Pool.GetNumHotIdle();
+		const bool bOverHotCapacity = Policy.MaxHotIdleCount > 0 && HotNum > Policy.MaxHotIdleCount;
+		const bool bIdleTimeout = Policy.ColdIdleTimeout > 0.f
+			&& HotNum > MinHotNum
+			&& Pool.IdleSinceTimes[Pool.NumColdIdle] + Policy.ColdIdleTimeout <= CurrentTime;
+		if (!bOverHotCapacity && !bIdleTimeout)
+		{
+			break;
+		}
+
+		FreezeIdleActor(Pool.ActorPool[Pool.NumColdIdle]);
+		++Pool.NumColdIdle;
+		--ChangeBudget;
+	}
+
+	// 热待命Actor被取用到下限以下时，逐帧把最近转为冷待命的Actor重新注册
+	int32 MaxHotNum = MinHotNum;
+	if (Policy.MaxHotIdleCount > 0)
+	{
+		MaxHotNum = FMath::Min(MaxHotNum, Policy.MaxHotIdleCount);
+	}
+	while (ChangeBudget > 0 && Pool.NumColdIdle > 0 && Pool.GetNumHotIdle() < MaxHotNum)
+	{
+		--Pool.NumColdIdle;
+		ThawIdleActor(Pool.ActorPool[Pool.NumColdIdle]);
+		--ChangeBudget;
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::FreezeIdleActor(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	if (FTireflyPooledActorRecord* Record = PooledActorRecords.Find(Actor))
+	{
+		Record->RegisteredComponentsWhenCold.Reset();
+		Record->ActiveComponentsWhenCold.Reset();
+		for (UActorComponent* Component : Actor->GetComponents())
+		{
+			if (!Component || !Component->IsRegistered())
+			{
+				continue;
+			}
+
+			Record->RegisteredComponentsWhenCold.Add(Component);
+			if (Component->IsActive())
+			{
+				Record->ActiveComponentsWhenCold.Add(Component);
+			}
+		}
+	}
+
+	Actor->UnregisterAllComponents();
+	TIREFLY_ACTOR_POOL_INC_COUNTER(Freezes, 1);
+}
+
+void UTireflyActorPoolWorldSubsystem::ThawIdleActor(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	FTireflyPooledActorRecord* Record = PooledActorRecords.Find(Actor);
+	if (!Record)
+	{
+		Actor->RegisterAllComponents();
+		TIREFLY_ACTOR_POOL_INC_COUNTER(Thaws, 1);
+		return;
+	}
+
+	// 只重新注册冷待命之前已经注册的组件，本来就未注册的组件保持原样
+	for (const TWeakObjectPtr<UActorComponent>& ComponentPtr : Record->RegisteredComponentsWhenCold)
+	{
+		TireflyActorPool::RegisterFrozenComponent(Actor, ComponentPtr.Get(), Record->RegisteredComponentsWhenCold);
+	}
+
+	// 注册时bAutoActivate的组件会被激活，恢复为转为冷待命之前的激活状态
+	for (const TWeakObjectPtr<UActorComponent>& ComponentPtr : Record->RegisteredComponentsWhenCold)
+	{
+		UActorComponent* Component = ComponentPtr.Get();
+		if (Component && Component->IsActive() && !Record->ActiveComponentsWhenCold.Contains(Component))
+		{
+			Component->Deactivate();
+		}
+	}
+
+	Record->RegisteredComponentsWhenCold.Empty();
+	Record->ActiveComponentsWhenCold.Empty();
+	TIREFLY_ACTOR_POOL_INC_COUNTER(Thaws, 1);
+}
+
+double UTireflyActorPoolWorldSubsystem::GetPoolTime() const
+{
+	const UWorld* World = GetWorld();
+	return IsValid(World) ? World->GetTimeSeconds() : 0.0;
+}
+
+FTireflyActorPool& UTireflyActorPoolWorldSubsystem::FindOrAddActorPool(const TSubclassOf<AActor>& ActorClass, FName ActorId)
+{
+	return ActorPools[FindOrAddActorPoolIndex(ActorClass, ActorId)];
+}
+
+int32 UTireflyActorPoolWorldSubsystem::FindOrAddActorPoolIndex(const TSubclassOf<AActor>& ActorClass, FName ActorId)
+{
+	const int32* ExistingIndex = (ActorId != NAME_None) ? ActorPoolIndexOfId.Find(ActorId) : ActorPoolIndexOfClass.Find(ActorClass);
+
+	int32 PoolIndex;
+	if (ExistingIndex)
+	{
+		PoolIndex = *ExistingIndex;
+	}
+	else
+	{
+		PoolIndex = FreeActorPoolIndices.IsEmpty() ? ActorPools.AddDefaulted() : FreeActorPoolIndices.Pop(EAllowShrinking::No);
+		ActorPools[PoolIndex].ActorId = ActorId;
+		ActorPools[PoolIndex].Serial = NextActorPoolSerial++;
+		if (ActorId != NAME_None)
+		{
+			ActorPoolIndexOfId.Add(ActorId, PoolIndex);
+		}
+		else
+		{
+			ActorPoolIndexOfClass.Add(ActorClass, PoolIndex);
+		}
+	}
+
+	if (ActorClass)
+	{
+		ActorPools[PoolIndex].ActorClass = ActorClass;
+	}
+
+	return PoolIndex;
+}
+
+FTireflyActorPool* UTireflyActorPoolWorldSubsystem::FindActorPool(const TSubclassOf<AActor>& ActorClass, FName ActorId)
+{
+	const int32* PoolIndex = (ActorId != NAME_None) ? ActorPoolIndexOfId.Find(ActorId) : ActorPoolIndexOfClass.Find(ActorClass);
+	return PoolIndex ? &ActorPools[*PoolIndex] : nullptr;
+}
+
+const FTireflyActorPool* UTireflyActorPoolWorldSubsystem::FindActorPool(const TSubclassOf<AActor>& ActorClass, FName ActorId) const
+{
+	const int32* PoolIndex = (ActorId != NAME_None) ? ActorPoolIndexOfId.Find(ActorId) : ActorPoolIndexOfClass.Find(ActorClass);
+	return PoolIndex ? &ActorPools[*PoolIndex] : nullptr;
+}
+
+void UTireflyActorPoolWorldSubsystem::TickActorPoolReplenishment(float DeltaTime)
+{
+	if (DeltaTime <= 0.f)
+	{
+		return;
+	}
+
+	for (const auto& PoolEntry : ActorPoolIndexOfClass)
+	{
+		ReplenishActorPool(ActorPools[PoolEntry.Value], NAME_None, DeltaTime);
+	}
+
+	for (const auto& PoolEntry : ActorPoolIndexOfId)
+	{
+		ReplenishActorPool(ActorPools[PoolEntry.Value], PoolEntry.Key, DeltaTime);
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::ReplenishActorPool(FTireflyActorPool& Pool, FName ActorId, float DeltaTime)
+{
+	// 以时间为权重的指数移动平均，不受帧率影响
+	const float DemandRate = Pool.DemandThisFrame / DeltaTime;
+	const float Alpha = 1.f - FMath::Exp(-DeltaTime / TireflyActorPool::DemandAverageTimeConstant);
+	Pool.DemandRateAverage += Alpha * (DemandRate - Pool.DemandRateAverage);
+	Pool.DemandThisFrame = 0;
+
+	const FTireflyActorPoolPolicy& Policy = Pool.Policy;
+	if (Policy.LowWatermark <= 0 || !Pool.ActorClass)
+	{
+		return;
+	}
+
+	if (Pool.ReplenishWarmUpHandle != INDEX_NONE)
+	{
+		if (IsWarmUpInProgress(Pool.ReplenishWarmUpHandle))
+		{
+			return;
+		}
+		Pool.ReplenishWarmUpHandle = INDEX_NONE;
+	}
+
+	const int32 IdleNum = Pool.ActorPool.Num();
+	if (IdleNum >= Policy.LowWatermark)
+	{
+		return;
+	}
+
+	int32 TargetNum = FMath::Max(Policy.ReplenishTarget, Policy.LowWatermark);
+	if (Policy.bAdaptiveReplenishTarget)
+	{
+		TargetNum = FMath::Max(TargetNum, FMath::CeilToInt32(Pool.DemandRateAverage * Policy.AdaptiveDemandWindow));
+	}
+	if (Policy.MaxIdleCount > 0)
+	{
+		TargetNum = FMath::Min(TargetNum, Policy.MaxIdleCount);
+	}
+
+	if (TargetNum > IdleNum)
+	{
+		Pool.ReplenishWarmUpHandle = QueueWarmUpActorPool(Pool.ActorClass, ActorId, TargetNum - IdleNum, Policy.ReplenishPriority);
+	}
+}
+
+AActor* UTireflyActorPoolWorldSubsystem::FetchActorFromPool(int32 PoolIndex)
+{
+	FTireflyActorPool& Pool = ActorPools[PoolIndex];
+	AActor* Actor = nullptr;
+	while (!Actor && !Pool.ActorPool.IsEmpty())
+	{
+		// 被外部销毁的待命Actor通常已在HandlePooledActorDestroyed中移除，这里跳过仍然残留的失效Actor
+		const bool bColdActor = Pool.GetNumHotIdle() <= 0;
+		AActor* IdleActor = Pool.PopIdleActor();
+		if (IsValid(IdleActor))
+		{
+			Actor = IdleActor;
+			if (bColdActor)
+			{
+				// 热待命Actor已经取完，只能同步重新注册冷待命Actor
+				ThawIdleActor(Actor);
+			}
+		}
+	}
+	Pool.RecordDemand(1, Actor ? 1 : 0, GetPoolTime());
+	TIREFLY_ACTOR_POOL_INC_COUNTER(Hits, Actor ? 1 : 0);
+	TIREFLY_ACTOR_POOL_INC_COUNTER(Misses, Actor ? 0 : 1);
+
+	return Actor;
+}
+
+int32 UTireflyActorPoolWorldSubsystem::FetchActorsFromPool(
+	int32 PoolIndex,
+	int32 Count,
+	TArray<AActor*>& OutActors)
+{
+	if (Count <= 0)
+	{
+		return 0;
+	}
+
+	FTireflyActorPool& Pool = ActorPools[PoolIndex];
+
+	// 从池的尾部一次性取出，与逐个Pop的顺序保持一致
+	const int32 PoolNum = Pool.ActorPool.Num();
+	int32 FetchNum = 0;
+	int32 Index = PoolNum - 1;
+	for (; Index >= 0 && FetchNum < Count; --Index)
+	{
+		// 跳过仍然残留的失效Actor，它们和取出的Actor一起从池中移除
+		AActor* Actor = Pool.ActorPool[Index];
+		if (!IsValid(Actor))
+		{
+			continue;
+		}
+
+		// 热待命Actor不够时，只能同步重新注册冷待命Actor
+		if (Index < Pool.NumColdIdle)
+		{
+			ThawIdleActor(Actor);
+		}
+		OutActors.Add(Actor);
+		++FetchNum;
+	}
+	Pool.RemoveIdleActorsFromTop(PoolNum - 1 - Index);
+	Pool.RecordDemand(Count, FetchNum, GetPoolTime());
+	TIREFLY_ACTOR_POOL_INC_COUNTER(Hits, FetchNum);
+	TIREFLY_ACTOR_POOL_INC_COUNTER(Misses, Count - FetchNum);
+
+	return FetchNum;
+}
+
+AActor* UTireflyActorPoolWorldSubsystem::SpawnNewActor_Internal(
+	UWorld* World,
+	const TSubclassOf<AActor>& ActorClass,
+	FName ActorId,
+	int32 PoolIndex,
+	const FTransform& Transform,
+	FTireflyPoolingInitialDataRef& InitialData,
+	const ESpawnActorCollisionHandlingMethod CollisionHandling,
+	AActor* Owner,
+	APawn* Instigator,
+	bool& bOutPoolingBeganPlay)
+{
+	const double SpawnStartTime = FPlatformTime::Seconds();
+	bOutPoolingBeganPlay = false;
+	AActor* Actor = nullptr;
+	if (ActorPools[PoolIndex].Policy.bDeferredColdSpawn)
+	{
+		// 构造脚本和BeginPlay推迟到FinishSpawning，此前Actor已经拿到Owner、Instigator、ActorId和初始化数据
+		Actor = World->SpawnActorDeferred<AActor>(ActorClass, Transform, Owner, Instigator, CollisionHandling);
+		if (IsValid(Actor))
+		{
+			if (ActorId != NAME_None)
+			{
+				FTireflyPoolingActorDispatch::PoolingSetActorId(Actor, ActorId);
+			}
+
+			// 快照在应用初始化数据之前捕获，回收时不会把本次的初始化数据当作默认状态
+			AddSpawnedActorRecord(Actor, PoolIndex);
+
+			// 与复用和即时生成保持相同的顺序：先PoolingBeginPlay，再PoolingInitialized
+			FTireflyPoolingActorDispatch::PoolingBeginPlay(Actor);
+			bOutPoolingBeganPlay = true;
+			if (InitialData.IsSet())
+			{
+				InitialData.Apply(Actor);
+				InitialData.Reset();
+			}
+
+			Actor->FinishSpawning(Transform);
+		}
+	}
+	else
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.Owner = Owner;
+		SpawnParameters.Instigator = Instigator;
+		SpawnParameters.SpawnCollisionHandlingOverride = CollisionHandling;
+
+		Actor = World->SpawnActor<AActor>(ActorClass, Transform, SpawnParameters);
+		if (IsValid(Actor) && ActorId != NAME_None)
+		{
+			FTireflyPoolingActorDispatch::PoolingSetActorId(Actor, ActorId);
+		}
+	}
+
+	++ColdSpawnsThisFrame;
+	ColdSpawnSecondsThisFrame += FPlatformTime::Seconds() - SpawnStartTime;
+	if (!IsValid(Actor))
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Failed to spawn ActorClass %s"),
+			*FString(__FUNCTION__),
+			*ActorClass->GetName());
+		return nullptr;
+	}
+
+	// 生成Actor的过程中可能有新的对象池被加入，需要通过索引重新获取对象池
+	FTireflyActorPool& Pool = ActorPools[PoolIndex];
+	++Pool.ColdSpawnCount;
+	TIREFLY_ACTOR_POOL_INC_COUNTER(ColdSpawns, 1);
+
+	if (!PooledActorRecords.Contains(Actor))
+	{
+		AddSpawnedActorRecord(Actor, PoolIndex);
+	}
+
+	return Actor;
+}
+
+void UTireflyActorPoolWorldSubsystem::AddSpawnedActorRecord(AActor* Actor, int32 PoolIndex)
+{
+	FTireflyPooledActorRecord& Record = AddPooledActorRecord(Actor, PoolIndex);
+	if (ActorPools[PoolIndex].Policy.bResetStateOnRecycle)
+	{
+		Record.Snapshot = MakeUnique<FTireflyActorStateSnapshot>(Actor);
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::ActivateActor_Internal(
+	UWorld* World,
+	AActor* Actor,
+	int32 PoolIndex,
+	const FTireflyPoolingInitialDataRef& InitialData,
+	float Lifetime,
+	bool bPoolingBeganPlay)
+{
+	// 不是由对象池生成、被回收进对象池的Actor在第一次取出时补上记录，之后回到这个对象池
+	FTireflyPooledActorRecord* Record = PooledActorRecords.Find(Actor);
+	AddActiveActor(Actor, PoolIndex, Record ? *Record : AddPooledActorRecord(Actor, PoolIndex));
+
+	if (!bPoolingBeganPlay)
+	{
+		FTireflyPoolingActorDispatch::PoolingBeginPlay(Actor);
+	}
+
+	if (InitialData.IsSet())
+	{
+		InitialData.Apply(Actor);
+	}
+
+	if (Lifetime > 0.f)
+	{
+		LifetimeWheel.Schedule(Actor, World->GetTimeSeconds() + Lifetime);
+	}
+}
+
+AActor* UTireflyActorPoolWorldSubsystem::SpawnActor_Internal(
+	const TSubclassOf<AActor>& ActorClass,
+	FName ActorId,
+	const FTransform& Transform,
+	const FTireflyPoolingInitialDataRef& InitialData,
+	float Lifetime,
+	const ESpawnActorCollisionHandlingMethod CollisionHandling,
+	AActor* Owner,
+	APawn* Instigator)
+{
+	TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(SpawnActor);
+
+	if (!IsInGameThread())
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Must be called on the game thread, use EnqueueSpawnActorFromPool from other threads"), *FString(__FUNCTION__));
+		return nullptr;
+	}
+
+	UWorld* World = GetWorld();
+	if (!IsValid(World))
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid World"), *FString(__FUNCTION__));
+		return nullptr;
+	}
+
+	if (!IsValid(ActorClass))
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid ActorClass"), *FString(__FUNCTION__));
+		return nullptr;
+	}
+
+	if (!FTireflyPoolingActorDispatch::Implements(ActorClass))
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] ActorClass %s does not implement UTireflyPoolingActorInterface"),
+			*FString(__FUNCTION__),
+			*ActorClass->GetName());
+		return nullptr;
+	}
+
+	const int32 PoolIndex = FindOrAddActorPoolIndex(ActorClass, ActorId);
+	return SpawnActorFromPoolIndex_Internal(World, ActorClass, ActorId, PoolIndex, Transform, InitialData, Lifetime, CollisionHandling, Owner, Instigator);
+}
+
+AActor* UTireflyActorPoolWorldSubsystem::SpawnActorFromPoolIndex_Internal(
+	UWorld* World,
+	const TSubclassOf<AActor>& ActorClass,
+	FName ActorId,
+	int32 PoolIndex,
+	const FTransform& Transform,
+	FTireflyPoolingInitialDataRef InitialData,
+	float Lifetime,
+	const ESpawnActorCollisionHandlingMethod CollisionHandling,
+	AActor* Owner,
+	APawn* Instigator)
+{
+	// 即时生成可能提前应用并清空初始化数据，代理需要原始的初始化数据
+	const FTireflyPoolingInitialDataRef RequestedData = InitialData;
+
+	bool bPoolingBeganPlay = false;
+	AActor* Actor = FetchActorFromPool(PoolIndex);
+	if (Actor)
+	{
+		Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+		Actor->SetInstigator(Instigator);
+		Actor->SetOwner(Owner);
+	}
+	else
+	{
+		Actor = SpawnNewActor_Internal(World, ActorClass, ActorId, PoolIndex, Transform, InitialData, CollisionHandling, Owner, Instigator, bPoolingBeganPlay);
+		if (!Actor)
+		{
+			return nullptr;
+		}
+	}
+
+	ActivateActor_Internal(World, Actor, PoolIndex, InitialData, Lifetime, bPoolingBeganPlay);
+	RememberProxyInitialData(Actor, PoolIndex, RequestedData);
+
+	return Actor;
+}
+
+void UTireflyActorPoolWorldSubsystem::RecycleMismatchedActor(AActor* Actor, const UClass* ExpectedClass)
+{
+	UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Spawned actor %s is not a %s, recycled it back to its pool"),
+		*FString(__FUNCTION__), *GetNameSafe(Actor->GetClass()), *GetNameSafe(ExpectedClass));
+
+	RecycleActorToPool(Actor);
+}
+
+void UTireflyActorPoolWorldSubsystem::SpawnActors_Internal(
+	const TSubclassOf<AActor>& ActorClass,
+	FName ActorId,
+	TConstArrayView<FTransform> Transforms,
+	TArray<AActor*>& OutActors,
+	TConstArrayView<FInstancedStruct> InitialData,
+	float Lifetime,
+	const ESpawnActorCollisionHandlingMethod CollisionHandling,
+	AActor* Owner,
+	APawn* Instigator)
+{
+	TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(SpawnActors);
+
+	if (!IsInGameThread())
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Must be called on the game thread, use EnqueueSpawnActorFromPool from other threads"), *FString(__FUNCTION__));
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	if (!IsValid(World))
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid World"), *FString(__FUNCTION__));
+		return;
+	}
+
+	if (!IsValid(ActorClass))
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid ActorClass"), *FString(__FUNCTION__));
+		return;
+	}
+
+	if (!FTireflyPoolingActorDispatch::Implements(ActorClass))
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] ActorClass %s does not implement UTireflyPoolingActorInterface"),
+			*FString(__FUNCTION__),
+			*ActorClass->GetName());
+		return;
+	}
+
+	const int32 Count = Transforms.Num();
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	const bool bSharedInitialData = InitialData.Num() == 1;
+	if (!InitialData.IsEmpty() && !bSharedInitialData && InitialData.Num() != Count)
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] InitialData count %d does not match Transforms count %d, extra instances will not be initialized"),
+			*FString(__FUNCTION__),
+			InitialData.Num(),
+			Count);
+	}
+
+	// 整个批次只查找一次对象池，一次性取出池中可用的Actor
+	TArray<AActor*> FetchedActors;
+	FetchedActors.Reserve(Count);
+	const int32 PoolIndex = FindOrAddActorPoolIndex(ActorClass, ActorId);
+	const int32 FetchedNum = FetchActorsFromPool(PoolIndex, Count, FetchedActors);
+
+	OutActors.Reserve(OutActors.Num() + Count);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const FTransform& Transform = Transforms[Index];
+
+		FTireflyPoolingInitialDataRef Data;
+		if (bSharedInitialData)
+		{
+			Data = &InitialData[0];
+		}
+		else if (InitialData.IsValidIndex(Index))
+		{
+			Data = &InitialData[Index];
+		}
+
+		const FTireflyPoolingInitialDataRef RequestedData = Data;
+		bool bPoolingBeganPlay = false;
+		AActor* Actor = Index < FetchedNum ? FetchedActors[Index] : nullptr;
+		if (IsValid(Actor))
+		{
+			Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+			Actor->SetInstigator(Instigator);
+			Actor->SetOwner(Owner);
+		}
+		else
+		{
+			// 只有池中不足的部分才会新生成
+			Actor = SpawnNewActor_Internal(World, ActorClass, ActorId, PoolIndex, Transform, Data, CollisionHandling, Owner, Instigator, bPoolingBeganPlay);
+			if (!Actor)
+			{
+				continue;
+			}
+		}
+
+		ActivateActor_Internal(World, Actor, PoolIndex, Data, Lifetime, bPoolingBeganPlay);
+		RememberProxyInitialData(Actor, PoolIndex, RequestedData);
+		OutActors.Add(Actor);
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::RecycleActorToPool(AActor* Actor)
+{
+	TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(RecycleActor);
+
+	// 其他线程上的回收转交给命令队列，在下一次Tick时由游戏线程执行
+	if (!IsInGameThread())
+	{
+		EnqueueRecycleActorToPool(Actor);
+		return;
+	}
+
+	if (!IsValid(Actor))
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Invalid Actor"), *FString(__FUNCTION__));
+		return;
+	}
+
+	// 由对象池生成的Actor直接回到生成它的对象池，不再查询Id和查找对象池
+	FTireflyPooledActorRecord* Record = PooledActorRecords.Find(Actor);
+	if (IsIdlePooledActor(Actor, Record, *FString(__FUNCTION__)))
+	{
+		return;
+	}
+
+	// 手动回收时取消尚未到期的存活时间，避免Actor被复用后再次被回收
+	LifetimeWheel.Cancel(Actor);
+
+	int32 PoolIndex = Record ? ResolveActorPoolIndex(Record->HomePool) : INDEX_NONE;
+
+	FName ActorId = NAME_None;
+	if (FTireflyPoolingActorDispatch::Implements(Actor->GetClass()))
+	{
+		if (PoolIndex == INDEX_NONE)
+		{
+			ActorId = FTireflyPoolingActorDispatch::PoolingGetActorId(Actor);
+		}
+		FTireflyPoolingActorDispatch::PoolingEndPlay(Actor);
+	}
+
+	if (PoolIndex == INDEX_NONE)
+	{
+		PoolIndex = FindOrAddActorPoolIndex(Actor->GetClass(), ActorId);
+	}
+
+	RecycleActorToPool_Internal(Actor, PoolIndex, Record);
+}
+
+void UTireflyActorPoolWorldSubsystem::RecycleActorToPool(AActor* Actor, const FTireflyActorPoolKey& PoolKey)
+{
+	const int32 PoolIndex = ResolveActorPoolIndex(PoolKey);
+	if (PoolIndex == INDEX_NONE || !IsInGameThread() || !IsValid(Actor))
+	{
+		RecycleActorToPool(Actor);
+		return;
+	}
+
+	// Class池只存放精确类型的Actor，类型化生成依赖这一点，类型不符的Actor回到它自己的对象池
+	const FTireflyActorPool& Pool = ActorPools[PoolIndex];
+	if (Pool.ActorId.IsNone() && Actor->GetClass() != Pool.ActorClass)
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Actor %s does not match the class pool of %s, recycled it to its own pool"),
+			*FString(__FUNCTION__), *GetNameSafe(Actor), *GetNameSafe(Pool.ActorClass.Get()));
+		RecycleActorToPool(Actor);
+		return;
+	}
+
+	TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(RecycleActor);
+
+	if (IsIdlePooledActor(Actor, PooledActorRecords.Find(Actor), *FString(__FUNCTION__)))
+	{
+		return;
+	}
+
+	LifetimeWheel.Cancel(Actor);
+	if (FTireflyPoolingActorDispatch::Implements(Actor->GetClass()))
+	{
+		FTireflyPoolingActorDispatch::PoolingEndPlay(Actor);
+	}
+
+	// 之后从这个对象池中取出的Actor也应该回到这个对象池
+	FTireflyPooledActorRecord* Record = PooledActorRecords.Find(Actor);
+	if (Record)
+	{
+		Record->HomePool = PoolKey;
+	}
+
+	RecycleActorToPool_Internal(Actor, PoolIndex, Record);
+}
+
+bool UTireflyActorPoolWorldSubsystem::IsIdlePooledActor(const AActor* Actor, const FTireflyPooledActorRecord* Record, const TCHAR* FunctionName)
+{
+	// 有记录但不在任何对象池的激活列表中，说明Actor已经在对象池中待命
+	if (!Record || Record->ActivePoolIndex != INDEX_NONE)
+	{
+		return false;
+	}
+
+	UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Actor %s is already idle in its pool, ignored the repeated recycle"), FunctionName, *GetNameSafe(Actor));
+	return true;
+}
+
+void UTireflyActorPoolWorldSubsystem::RecycleActorToPool_Internal(AActor* Actor, int32 PoolIndex, FTireflyPooledActorRecord* Record)
+{
+	if (Record)
+	{
+		RemoveActiveActor(Actor, *Record);
+	}
+	else
+	{
+		// 不是由对象池生成的Actor也要登记，待命期间被外部销毁时才能从对象池中移除
+		AddPooledActorRecord(Actor, PoolIndex);
+	}
+
+	FTireflyActorPool& Pool = ActorPools[PoolIndex];
+	++Pool.RecycleCount;
+	TIREFLY_ACTOR_POOL_INC_COUNTER(Recycles, 1);
+	if (Pool.Policy.MaxIdleCount > 0 && Pool.ActorPool.Num() >= Pool.Policy.MaxIdleCount)
+	{
+		// 对象池已满，超出容量的Actor直接销毁，避免对象池只增不减
+		Actor->Destroy();
+		return;
+	}
+
+	if (Record && Record->Snapshot)
+	{
+		Record->Snapshot->Restore(Actor);
+	}
+
+	Pool.PushIdleActor(Actor, GetPoolTime());
+}
+
+void UTireflyActorPoolWorldSubsystem::ForEachActiveActorOfPool(TSubclassOf<AActor> ActorClass, FName ActorId, TFunctionRef<void(AActor*)> Function) const
+{
+	if (const FTireflyActorPool* Pool = FindActorPool(ActorClass, ActorId))
+	{
+		for (AActor* Actor : Pool->ActiveActors)
+		{
+			if (IsValid(Actor))
+			{
+				Function(Actor);
+			}
+		}
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::ForEachActiveActor(const FTireflyActorPoolKey& PoolKey, TFunctionRef<void(AActor*)> Function) const
+{
+	const int32 PoolIndex = ResolveActorPoolIndex(PoolKey);
+	if (PoolIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	for (AActor* Actor : ActorPools[PoolIndex].ActiveActors)
+	{
+		if (IsValid(Actor))
+		{
+			Function(Actor);
+		}
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::GetActiveActorsOfPool(TSubclassOf<AActor> ActorClass, FName ActorId, TArray<AActor*>& OutActors) const
+{
+	OutActors.Reset();
+	ForEachActiveActorOfPool(ActorClass, ActorId, [&OutActors](AActor* Actor)
+	{
+		OutActors.Add(Actor);
+	});
+}
+
+int32 UTireflyActorPoolWorldSubsystem::GetActiveActorCountOfPool(TSubclassOf<AActor> ActorClass, FName ActorId) const
+{
+	const FTireflyActorPool* Pool = FindActorPool(ActorClass, ActorId);
+	return Pool ? Pool->ActiveActors.Num() : 0;
+}
+
+void UTireflyActorPoolWorldSubsystem::RecycleAllActiveActorsOfClass(TSubclassOf<AActor> ActorClass)
+{
+	if (const int32* PoolIndex = ActorPoolIndexOfClass.Find(ActorClass))
+	{
+		RecycleAllActiveActors_Internal(*PoolIndex);
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::RecycleAllActiveActorsOfId(FName ActorId)
+{
+	if (const int32* PoolIndex = ActorPoolIndexOfId.Find(ActorId))
+	{
+		RecycleAllActiveActors_Internal(*PoolIndex);
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::RecycleAllActiveActors(const FTireflyActorPoolKey& PoolKey)
+{
+	const int32 PoolIndex = ResolveActorPoolIndex(PoolKey);
+	if (PoolIndex != INDEX_NONE)
+	{
+		RecycleAllActiveActors_Internal(PoolIndex);
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::AddActiveActor(AActor* Actor, int32 PoolIndex, FTireflyPooledActorRecord& Record)
+{
+	// 被外部直接重新激活的Actor可能仍登记在其他对象池中
+	RemoveActiveActor(Actor, Record);
+
+	// 激活数量直接取ActiveActors的数量，外部销毁和按句柄回收都不会让两者不一致
+	FTireflyActorPool& Pool = ActorPools[PoolIndex];
+	Record.ActivePoolIndex = PoolIndex;
+	Record.ActiveSlot = Pool.ActiveActors.Add(Actor);
+	Pool.PeakActiveCount = FMath::Max(Pool.PeakActiveCount, Pool.ActiveActors.Num());
+}
+
+void UTireflyActorPoolWorldSubsystem::RemoveActiveActor(AActor* Actor, FTireflyPooledActorRecord& Record)
+{
+	// 对象池被清理或位置被复用后，记录中的位置不再指向该Actor
+	if (ActorPools.IsValidIndex(Record.ActivePoolIndex))
+	{
+		TArray<AActor*>& ActiveActors = ActorPools[Record.ActivePoolIndex].ActiveActors;
+		if (ActiveActors.IsValidIndex(Record.ActiveSlot) && ActiveActors[Record.ActiveSlot] == Actor)
+		{
+			ActiveActors.RemoveAtSwap(Record.ActiveSlot, 1, EAllowShrinking::No);
+			if (ActiveActors.IsValidIndex(Record.ActiveSlot))
+			{
+				if (FTireflyPooledActorRecord* MovedRecord = PooledActorRecords.Find(ActiveActors[Record.ActiveSlot]))
+				{
+					MovedRecord->ActiveSlot = Record.ActiveSlot;
+				}
+			}
+		}
+	}
+
+	Record.ActivePoolIndex = INDEX_NONE;
+	Record.ActiveSlot = INDEX_NONE;
+}
+
+void UTireflyActorPoolWorldSubsystem::RecycleAllActiveActors_Internal(int32 PoolIndex)
+{
+	TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(RecycleAllActiveActors);
+
+	if (!IsInGameThread())
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Must be called on the game thread"), *FString(__FUNCTION__));
+		return;
+	}
+
+	// 代理对应的Actor已经回收，直接移除代理
+	FTireflyActorPool& Pool = ActorPools[PoolIndex];
+	if (IsValid(Pool.ProxyComponent))
+	{
+		Pool.ProxyComponent->ClearInstances();
+	}
+	Pool.Proxies.Reset();
+
+	// 先取走整个激活列表，PoolingEndPlay中生成的新Actor会进入新的列表，不会在本批次中被回收
+	const FTireflyActorPoolKey PoolKey = MakeActorPoolKey(PoolIndex);
+	TArray<AActor*> Actors = MoveTemp(Pool.ActiveActors);
+	Pool.ActiveActors.Reset();
+
+	// 批次中的Actor保留ActivePoolIndex、清除ActiveSlot，以区分PoolingEndPlay中被单独回收或重新取出的Actor
+	for (AActor* Actor : Actors)
+	{
+		if (FTireflyPooledActorRecord* Record = PooledActorRecords.Find(Actor))
+		{
+			Record->ActiveSlot = INDEX_NONE;
+		}
+	}
+
+	for (AActor* Actor : Actors)
+	{
+		if (IsValid(Actor))
+		{
+			LifetimeWheel.Cancel(Actor);
+			if (FTireflyPoolingActorDispatch::Implements(Actor->GetClass()))
+			{
+				FTireflyPoolingActorDispatch::PoolingEndPlay(Actor);
+			}
+		}
+	}
+
+	// PoolingEndPlay中可能销毁或回收了Actor，放回对象池前重新查找记录
+	for (AActor* Actor : Actors)
+	{
+		if (!IsValid(Actor) || ResolveActorPoolIndex(PoolKey) == INDEX_NONE)
+		{
+			continue;
+		}
+
+		FTireflyPooledActorRecord* Record = PooledActorRecords.Find(Actor);
+		if (!Record || Record->ActivePoolIndex != PoolIndex || Record->ActiveSlot != INDEX_NONE)
+		{
+			continue;
+		}
+
+		RecycleActorToPool_Internal(Actor, PoolIndex, Record);
+	}
+}
+
+int32 UTireflyActorPoolWorldSubsystem::GetProxyCountOfPool(TSubclassOf<AActor> ActorClass, FName ActorId) const
+{
+	const FTireflyActorPool* Pool = FindActorPool(ActorClass, ActorId);
+	return Pool ? Pool->Proxies.Num() : 0;
+}
+
+void UTireflyActorPoolWorldSubsystem::TickActorPoolProxies()
+{
+	TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(TickActorPoolProxies);
+
+	// 专用服务器不渲染，代理没有意义
+	const UWorld* World = GetWorld();
+	if (!IsValid(World) || World->GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	// 切换过程中生成的Actor可能创建新的对象池，先收集需要处理的对象池
+	TArray<int32, TInlineAllocator<16>> PoolIndices;
+	for (int32 PoolIndex = 0; PoolIndex < ActorPools.Num(); ++PoolIndex)
+	{
+		const FTireflyActorPool& Pool = ActorPools[PoolIndex];
+		if (Pool.Serial != 0 && ((Pool.Policy.bUseInstancedProxy && !Pool.bProxyUnavailable) || !Pool.Proxies.IsEmpty()))
+		{
+			PoolIndices.Add(PoolIndex);
+		}
+	}
+
+	if (PoolIndices.IsEmpty())
+	{
+		return;
+	}
+
+	// 所有玩家的视点，监听服务器上也包括远程玩家，保证他们附近的Actor完整存在
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+	for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		if (const APlayerController* PlayerController = Iterator->Get())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+
+	if (ViewLocations.IsEmpty())
+	{
+		return;
+	}
+
+	for (const int32 PoolIndex : PoolIndices)
+	{
+		ProxyActorPool(PoolIndex, ViewLocations);
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::ProxyActorPool(int32 PoolIndex, TConstArrayView<FVector> ViewLocations)
+{
+	// 切换过程中ActorPools可能扩容，策略按值复制，对象池每次通过索引获取
+	const FTireflyActorPoolPolicy Policy = ActorPools[PoolIndex].Policy;
+	int32 SwapBudget = FMath::Max(Policy.MaxProxySwapsPerFrame, 1);
+
+	auto GetViewDistanceSquared = [ViewLocations](const FVector& Location)
+	{
+		double DistanceSquared = TNumericLimits<double>::Max();
+		for (const FVector& ViewLocation : ViewLocations)
+		{
+			DistanceSquared = FMath::Min(DistanceSquared, FVector::DistSquared(Location, ViewLocation));
+		}
+		return DistanceSquared;
+	};
+
+	// 玩家靠近的代理还原为Actor，关闭代理后逐帧把所有代理还原；倒序遍历，移除时填补空位的代理已经检查过
+	const double HydrateDistance = FMath::Max(Policy.ProxyDistance - FMath::Max(Policy.ProxyHysteresis, 0.f), 0.f);
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	for (int32 ProxyIndex = ActorPools[PoolIndex].Proxies.Num() - 1; ProxyIndex >= 0 && SwapBudget > 0; --ProxyIndex)
+	{
+		FTireflyActorPool& Pool = ActorPools[PoolIndex];
+		if (!Pool.Proxies.IsValidIndex(ProxyIndex))
+		{
+			continue;
+		}
+
+		// 存活时间在代理期间到期，Actor不再需要重新生成
+		const double ExpireTime = Pool.Proxies[ProxyIndex].ExpireTime;
+		if (ExpireTime >= 0.0 && ExpireTime <= CurrentTime)
+		{
+			TireflyActorPool::RemoveProxy(Pool, ProxyIndex);
+			continue;
+		}
+
+		// 对象池中没有待命Actor时需要即时生成，受每帧的即时生成预算限制
+		if (Pool.ActorPool.IsEmpty() && !HasColdSpawnBudget())
+		{
+			break;
+		}
+
+		if (!Policy.bUseInstancedProxy || GetViewDistanceSquared(Pool.Proxies[ProxyIndex].ActorTransform.GetLocation()) < FMath::Square(HydrateDistance))
+		{
+			HydrateProxy(PoolIndex, ProxyIndex);
+			--SwapBudget;
+		}
+	}
+
+	if (!Policy.bUseInstancedProxy || SwapBudget <= 0 || ActorPools[PoolIndex].bProxyUnavailable)
+	{
+		return;
+	}
+
+	// 从上一帧停下的位置继续检查激活的Actor，先收集再替换，替换会改变激活Actor的排列
+	TArray<AActor*, TInlineAllocator<16>> FarActors;
+	{
+		FTireflyActorPool& Pool = ActorPools[PoolIndex];
+		const int32 ActiveNum = Pool.ActiveActors.Num();
+		const double ProxyDistanceSquared = FMath::Square(static_cast<double>(Policy.ProxyDistance));
+		int32 Checked = 0;
+		for (; Checked < ActiveNum && FarActors.Num() < SwapBudget; ++Checked)
+		{
+			AActor* Actor = Pool.ActiveActors[(Pool.ProxyScanCursor + Checked) % ActiveNum];
+			if (IsValid(Actor) && GetViewDistanceSquared(Actor->GetActorLocation()) > ProxyDistanceSquared)
+			{
+				FarActors.Add(Actor);
+			}
+		}
+		Pool.ProxyScanCursor = ActiveNum > 0 ? (Pool.ProxyScanCursor + Checked) % ActiveNum : 0;
+	}
+
+	for (AActor* Actor : FarActors)
+	{
+		if (IsValid(Actor))
+		{
+			DehydrateActor(PoolIndex, Actor);
+		}
+	}
+}
+
+bool UTireflyActorPoolWorldSubsystem::DehydrateActor(int32 PoolIndex, AActor* Actor)
+{
+	FTireflyPooledActorRecord* Record = PooledActorRecords.Find(Actor);
+	if (Record && Record->bTypedInitialData)
+	{
+		return false;
+	}
+
+	UInstancedStaticMeshComponent* ProxyComponent = FindOrCreateProxyComponent(PoolIndex, Actor);
+	if (!ProxyComponent)
+	{
+		return false;
+	}
+
+	// 代理实例使用网格体组件的Transform，重新生成Actor时使用Actor的Transform
+	const UStaticMeshComponent* MeshComponent = Actor->FindComponentByClass<UStaticMeshComponent>();
+	const FTransform InstanceTransform = MeshComponent ? MeshComponent->GetComponentTransform() : Actor->GetActorTransform();
+
+	// 回收会取消存活时间，PoolingEndPlay中还可能生成新的Actor使记录失效，需要在回收前取出要恢复的内容
+	FTireflyActorPoolProxy Proxy;
+	Proxy.ActorTransform = Actor->GetActorTransform();
+	Proxy.ExpireTime = LifetimeWheel.GetExpireTime(Actor);
+	Proxy.Owner = Actor->GetOwner();
+	Proxy.Instigator = Actor->GetInstigator();
+	if (Record)
+	{
+		Proxy.InitialData = MoveTemp(Record->ProxyInitialData);
+	}
+
+	RecycleActorToPool(Actor, MakeActorPoolKey(PoolIndex));
+
+	ProxyComponent->AddInstance(InstanceTransform, true);
+	ActorPools[PoolIndex].Proxies.Add(MoveTemp(Proxy));
+	TIREFLY_ACTOR_POOL_INC_COUNTER(Dehydrations, 1);
+
+	return true;
+}
+
+void UTireflyActorPoolWorldSubsystem::HydrateProxy(int32 PoolIndex, int32 ProxyIndex)
+{
+	FTireflyActorPool& Pool = ActorPools[PoolIndex];
+	const FTireflyActorPoolProxy Proxy = MoveTemp(Pool.Proxies[ProxyIndex]);
+	const TSubclassOf<AActor> ActorClass = Pool.ActorClass;
+	const FName ActorId = Pool.ActorId;
+	TireflyActorPool::RemoveProxy(Pool, ProxyIndex);
+
+	if (IsValid(ActorClass))
+	{
+		// 继续使用代理前剩余的存活时间，到期的代理已经在此之前移除
+		UWorld* World = GetWorld();
+		const float Lifetime = Proxy.ExpireTime >= 0.0 ? FMath::Max(static_cast<float>(Proxy.ExpireTime - World->GetTimeSeconds()), UE_KINDA_SMALL_NUMBER) : -1.f;
+		const FInstancedStruct* InitialData = Proxy.InitialData.IsValid() ? &Proxy.InitialData : nullptr;
+
+		SpawnActorFromPoolIndex_Internal(World, ActorClass, ActorId, PoolIndex, Proxy.ActorTransform, InitialData, Lifetime,
+			ESpawnActorCollisionHandlingMethod::AlwaysSpawn, Proxy.Owner.Get(), Proxy.Instigator.Get());
+		TIREFLY_ACTOR_POOL_INC_COUNTER(Hydrations, 1);
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::RememberProxyInitialData(AActor* Actor, int32 PoolIndex, const FTireflyPoolingInitialDataRef& InitialData)
+{
+	// 只有使用代理的对象池需要复制初始化数据，其他对象池不承担复制的开销
+	if (!ActorPools[PoolIndex].Policy.bUseInstancedProxy)
+	{
+		return;
+	}
+
+	if (FTireflyPooledActorRecord* Record = PooledActorRecords.Find(Actor))
+	{
+		const FInstancedStruct* InstancedStruct = InitialData.GetInstancedStruct();
+		Record->ProxyInitialData = InstancedStruct ? *InstancedStruct : FInstancedStruct();
+		Record->bTypedInitialData = InitialData.IsTyped();
+	}
+}
+
+UInstancedStaticMeshComponent* UTireflyActorPoolWorldSubsystem::FindOrCreateProxyComponent(int32 PoolIndex, const AActor* SourceActor)
+{
+	if (IsValid(ActorPools[PoolIndex].ProxyComponent))
+	{
+		return ActorPools[PoolIndex].ProxyComponent;
+	}
+
+	const UStaticMeshComponent* MeshComponent = SourceActor->FindComponentByClass<UStaticMeshComponent>();
+	UStaticMesh* ProxyMesh = ActorPools[PoolIndex].Policy.ProxyMesh;
+	if (!ProxyMesh && MeshComponent)
+	{
+		ProxyMesh = MeshComponent->GetStaticMesh();
+	}
+
+	if (!ProxyMesh)
+	{
+		// 只检查一次，之后不再尝试替换这个对象池的Actor
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] %s has no static mesh for instanced proxies, proxies are disabled for its pool"),
+			*FString(__FUNCTION__), *GetNameSafe(SourceActor->GetClass()));
+		ActorPools[PoolIndex].bProxyUnavailable = true;
+		return nullptr;
+	}
+
+	if (!IsValid(ProxyHostActor))
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		ProxyHostActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+		if (!IsValid(ProxyHostActor))
+		{
+			UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Failed to spawn the proxy host actor"), *FString(__FUNCTION__));
+			return nullptr;
+		}
+
+		USceneComponent* RootComponent = NewObject<USceneComponent>(ProxyHostActor, TEXT("ProxyRoot"));
+		RootComponent->SetMobility(EComponentMobility::Movable);
+		ProxyHostActor->SetRootComponent(RootComponent);
+		RootComponent->RegisterComponent();
+	}
+
+	// 代理只负责显示，不参与碰撞
+	UInstancedStaticMeshComponent* ProxyComponent = NewObject<UInstancedStaticMeshComponent>(ProxyHostActor);
+	ProxyComponent->SetMobility(EComponentMobility::Movable);
+	ProxyComponent->SetStaticMesh(ProxyMesh);
+	ProxyComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	ProxyComponent->bSupportRemoveAtSwap = true;
+	if (!ActorPools[PoolIndex].Policy.ProxyMesh && MeshComponent)
+	{
+		for (int32 MaterialIndex = 0; MaterialIndex < MeshComponent->GetNumMaterials(); ++MaterialIndex)
+		{
+			ProxyComponent->SetMaterial(MaterialIndex, MeshComponent->GetMaterial(MaterialIndex));
+		}
+	}
+	ProxyComponent->SetupAttachment(ProxyHostActor->GetRootComponent());
+	ProxyComponent->RegisterComponent();
+	ProxyHostActor->AddInstanceComponent(ProxyComponent);
+
+	ActorPools[PoolIndex].ProxyComponent = ProxyComponent;
+	return ProxyComponent;
+}
+
+void UTireflyActorPoolWorldSubsystem::ClearActorPoolProxies(FTireflyActorPool& Pool)
+{
+	if (IsValid(Pool.ProxyComponent))
+	{
+		Pool.ProxyComponent->DestroyComponent();
+	}
+
+	Pool.ProxyComponent = nullptr;
+	Pool.Proxies.Empty();
+	Pool.ProxyScanCursor = 0;
+}
+
+int32 UTireflyActorPoolWorldSubsystem::BindTypedActorPool(int32 TypeSlot, const TSubclassOf<AActor>& ActorClass)
+{
+	if (TypedActorPoolIndices.Num() <= TypeSlot)
+	{
+		const int32 OldNum = TypedActorPoolIndices.Num();
+		TypedActorPoolIndices.SetNumUninitialized(TypeSlot + 1);
+		for (int32 Index = OldNum; Index <= TypeSlot; ++Index)
+		{
+			TypedActorPoolIndices[Index] = INDEX_NONE;
+		}
+	}
+
+	const int32 PoolIndex = FindOrAddActorPoolIndex(ActorClass, NAME_None);
+	TypedActorPoolIndices[TypeSlot] = PoolIndex;
+
+	return PoolIndex;
+}
+
+AActor* UTireflyActorPoolWorldSubsystem::SpawnTypedActor_Internal(
+	int32 PoolIndex,
+	const TSubclassOf<AActor>& ActorClass,
+	const FTransform& Transform,
+	const FTireflyPoolingInitialDataRef& InitialData,
+	float Lifetime,
+	const ESpawnActorCollisionHandlingMethod CollisionHandling,
+	AActor* Owner,
+	APawn* Instigator)
+{
+	TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(SpawnActor);
+
+	if (!IsInGameThread())
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Must be called on the game thread, use EnqueueSpawnActorFromPool from other threads"), *FString(__FUNCTION__));
+		return nullptr;
+	}
+
+	UWorld* World = GetWorld();
+	if (!IsValid(World))
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid World"), *FString(__FUNCTION__));
+		return nullptr;
+	}
+
+	// Actor类型和接口已在编译期检查，这里不再查找对象池
+	return SpawnActorFromPoolIndex_Internal(World, ActorClass, NAME_None, PoolIndex, Transform, InitialData, Lifetime, CollisionHandling, Owner, Instigator);
+}
+
+void UTireflyActorPoolWorldSubsystem::RecycleTypedActor_Internal(AActor* Actor, ITireflyPoolingActorInterface* PoolingInterface, int32 PoolIndex)
+{
+	TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(RecycleActor);
+
+	if (!IsInGameThread())
+	{
+		RecycleActorToPool(Actor);
+		return;
+	}
+
+	// 由其他对象池（例如同类型的Id池）生成的Actor回到它自己的对象池
+	// Actor的精确类型是C++类型，接口事件不会被蓝图覆盖，可以直接调用_Implementation
+	FTireflyPooledActorRecord* Record = PooledActorRecords.Find(Actor);
+	const bool bOtherPool = Record
+		? ResolveActorPoolIndex(Record->HomePool) != PoolIndex
+		: PoolingInterface->PoolingGetActorId_Implementation() != NAME_None;
+	if (bOtherPool)
+	{
+		RecycleActorToPool(Actor);
+		return;
+	}
+
+	if (IsIdlePooledActor(Actor, Record, *FString(__FUNCTION__)))
+	{
+		return;
+	}
+
+	LifetimeWheel.Cancel(Actor);
+	PoolingInterface->PoolingEndPlay_Implementation();
+
+	RecycleActorToPool_Internal(Actor, PoolIndex, Record);
+}
+
+void UTireflyActorPoolWorldSubsystem::SetActorLifetime(AActor* Actor, float Lifetime)
+{
+	if (!IsValid(Actor))
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Invalid Actor"), *FString(__FUNCTION__));
+		return;
+	}
+
+	if (Lifetime <= 0.f)
+	{
+		LifetimeWheel.Cancel(Actor);
+		return;
+	}
+
+	const UWorld* World = GetWorld();
+	if (!IsValid(World))
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid World"), *FString(__FUNCTION__));
+		return;
+	}
+
+	LifetimeWheel.Schedule(Actor, World->GetTimeSeconds() + Lifetime);
+}
+
+bool UTireflyActorPoolWorldSubsystem::ExtendActorLifetime(AActor* Actor, float ExtraTime)
+{
+	if (!IsValid(Actor))
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Invalid Actor"), *FString(__FUNCTION__));
+		return false;
+	}
+
+	const double ExpireTime = LifetimeWheel.GetExpireTime(Actor);
+	if (ExpireTime < 0.0)
+	{
+		return false;
+	}
+
+	LifetimeWheel.Schedule(Actor, ExpireTime + ExtraTime);
+	return true;
+}
+
+void UTireflyActorPoolWorldSubsystem::ClearActorLifetime(AActor* Actor)
+{
+	LifetimeWheel.Cancel(Actor);
+}
+
+float UTireflyActorPoolWorldSubsystem::GetActorRemainingLifetime(AActor* Actor) const
+{
+	const UWorld* World = GetWorld();
+	const double ExpireTime = LifetimeWheel.GetExpireTime(Actor);
+	if (ExpireTime < 0.0 || !IsValid(World))
+	{
+		return -1.f;
+	}
+
+	return FMath::Max(static_cast<float>(ExpireTime - World->GetTimeSeconds()), 0.f);
+}
+
+void UTireflyActorPoolWorldSubsystem::TickActorLifetimes()
+{
+	TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(TickActorLifetimes);
+
+	const UWorld* World = GetWorld();
+	if (!IsValid(World) || LifetimeWheel.Num() == 0)
+	{
+		return;
+	}
+
+	ExpiredActors.Reset();
+	LifetimeWheel.Advance(World->GetTimeSeconds(), ExpiredActors);
+	if (ExpiredActors.IsEmpty())
+	{
+		return;
+	}
+
+	// 同一帧内到期的Actor批量回收
+	for (AActor* Actor : ExpiredActors)
+	{
+		if (IsValid(Actor))
+		{
+			RecycleActorToPool(Actor);
+		}
+	}
+	ExpiredActors.Reset();
+}
+
+void UTireflyActorPoolWorldSubsystem::WarmUpActorPool(
+	TSubclassOf<AActor> ActorClass,
+	FName ActorId,
+	int32 Count)
+{
+	TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(WarmUpActorPool);
+
+	if (!IsValid(ActorClass))
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Invalid ActorClass"), *FString(__FUNCTION__));
+		return;
+	}
+
+	if (!FTireflyPoolingActorDispatch::Implements(ActorClass))
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] ActorClass %s does not implement UTireflyPoolingActorInterface"),
+			*FString(__FUNCTION__),
+			*ActorClass->GetName());
+		return;
+	}
+
+	if (Count <= 0)
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Count must be greater than 0"), *FString(__FUNCTION__));
+		return;
+	}
+	
+	UWorld* World = GetWorld();
+	if (!IsValid(World))
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid World"), *FString(__FUNCTION__));
+		return;
+	}
+
+	FTireflyActorPool& Pool = FindOrAddActorPool(ActorClass, ActorId);
+	if (Pool.Policy.MaxIdleCount > 0)
+	{
+		Count = FMath::Min(Count, Pool.Policy.MaxIdleCount - Pool.ActorPool.Num());
+		if (Count <= 0)
+		{
+			return;
+		}
+	}
+	
+	TArray<AActor*> WarmUpActors;
+	WarmUpActors.Reserve(Count);
+	for (int32 i = 0; i < Count; i++)
+	{
+		if (AActor* Actor = SpawnWarmUpActor_Internal(World, ActorClass, ActorId))
+		{
+			WarmUpActors.Add(Actor);
+		}
+	}
+
+	// 生成Actor的过程中可能有新的对象池被加入，需要重新查找对象池
+	FTireflyActorPool& WarmUpPool = FindOrAddActorPool(ActorClass, ActorId);
+	WarmUpPool.ActorPool.Reserve(WarmUpPool.ActorPool.Num() + WarmUpActors.Num());
+
+	const double CurrentTime = World->GetTimeSeconds();
+	for (AActor* Actor : WarmUpActors)
+	{
+		WarmUpPool.PushIdleActor(Actor, CurrentTime);
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::WarmUpActorPool(const FTireflyActorPoolKey& PoolKey, int32 Count)
+{
+	const int32 PoolIndex = ResolveActorPoolIndex(PoolKey);
+	if (PoolIndex == INDEX_NONE)
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Invalid or expired PoolKey"), *FString(__FUNCTION__));
+		return;
+	}
+
+	const FTireflyActorPool& Pool = ActorPools[PoolIndex];
+	WarmUpActorPool(Pool.ActorClass, Pool.ActorId, Count);
+}
+
+AActor* UTireflyActorPoolWorldSubsystem::SpawnWarmUpActor_Internal(UWorld* World, const TSubclassOf<AActor>& ActorClass, FName ActorId)
+{
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AActor* Actor = World->SpawnActor<AActor>(ActorClass, FTransform::Identity, SpawnParameters);
+	if (!IsValid(Actor))
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Failed to spawn ActorClass %s"),
+			*FString(__FUNCTION__),
+			*ActorClass->GetName());
+		return nullptr;
+	}
+
+	if (ActorId != NAME_None)
+	{
+		FTireflyPoolingActorDispatch::PoolingSetActorId(Actor, ActorId);
+	}
+
+	const int32 PoolIndex = FindOrAddActorPoolIndex(ActorClass, ActorId);
+	FTireflyActorPool& Pool = ActorPools[PoolIndex];
+	++Pool.ColdSpawnCount;
+	TIREFLY_ACTOR_POOL_INC_COUNTER(ColdSpawns, 1);
+
+	// 快照在预热处理之前捕获，与即时生成的Actor保持一致
+	FTireflyPooledActorRecord& Record = AddPooledActorRecord(Actor, PoolIndex);
+	if (Pool.Policy.bResetStateOnRecycle)
+	{
+		Record.Snapshot = MakeUnique<FTireflyActorStateSnapshot>(Actor);
+	}
+
+	FTireflyPoolingActorDispatch::PoolingWarmUp(Actor);
+
+	return Actor;
+}
+
+int32 UTireflyActorPoolWorldSubsystem::QueueWarmUpActorPool(
+	TSubclassOf<AActor> ActorClass,
+	FName ActorId,
+	int32 Count,
+	int32 Priority,
+	FSimpleDelegate OnCompleted)
+{
+	if (!IsValid(ActorClass))
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Invalid ActorClass"), *FString(__FUNCTION__));
+		return INDEX_NONE;
+	}
+
+	if (!FTireflyPoolingActorDispatch::Implements(ActorClass))
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] ActorClass %s does not implement UTireflyPoolingActorInterface"),
+			*FString(__FUNCTION__),
+			*ActorClass->GetName());
+		return INDEX_NONE;
+	}
+
+	if (Count <= 0)
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Count must be greater than 0"), *FString(__FUNCTION__));
+		return INDEX_NONE;
+	}
+
+	FTireflyActorPoolWarmUpJob Job;
+	Job.Handle = NextWarmUpHandle++;
+	Job.ActorClass = ActorClass.Get();
+	Job.ActorId = ActorId;
+	Job.TotalCount = Count;
+	Job.Priority = Priority;
+	Job.OnCompleted = MoveTemp(OnCompleted);
+
+	// 插入到第一个优先级更低的任务之前，相同优先级的任务保持加入顺序
+	const int32 InsertIndex = WarmUpQueue.IndexOfByPredicate([Priority](const FTireflyActorPoolWarmUpJob& Other)
+	{
+		return Other.Priority < Priority;
+	});
+	const int32 Handle = Job.Handle;
+	WarmUpQueue.Insert(MoveTemp(Job), InsertIndex == INDEX_NONE ? WarmUpQueue.Num() : InsertIndex);
+
+	return Handle;
+}
+
+int32 UTireflyActorPoolWorldSubsystem::QueueWarmUpActorPool(
+	const FTireflyActorPoolKey& PoolKey,
+	int32 Count,
+	int32 Priority,
+	FSimpleDelegate OnCompleted)
+{
+	const int32 PoolIndex = ResolveActorPoolIndex(PoolKey);
+	if (PoolIndex == INDEX_NONE)
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Invalid or expired PoolKey"), *FString(__FUNCTION__));
+		return INDEX_NONE;
+	}
+
+	const FTireflyActorPool& Pool = ActorPools[PoolIndex];
+	return QueueWarmUpActorPool(Pool.ActorClass, Pool.ActorId, Count, Priority, MoveTemp(OnCompleted));
+}
+
+int32 UTireflyActorPoolWorldSubsystem::K2_QueueWarmUpActorPool(
+	TSubclassOf<AActor> ActorClass,
+	FName ActorId,
+	const FTireflyActorPoolWarmUpCompletedDelegate& OnCompleted,
+	int32 Count,
+	int32 Priority)
+{
+	FSimpleDelegate NativeOnCompleted;
+	if (OnCompleted.IsBound())
+	{
+		const int32 Handle = NextWarmUpHandle;
+		NativeOnCompleted.BindWeakLambda(this, [OnCompleted, Handle, ActorClass, ActorId]()
+		{
+			OnCompleted.ExecuteIfBound(Handle, ActorClass, ActorId);
+		});
+	}
+
+	return QueueWarmUpActorPool(ActorClass, ActorId, Count, Priority, MoveTemp(NativeOnCompleted));
+}
+
+void UTireflyActorPoolWorldSubsystem::CancelWarmUp(int32 WarmUpHandle)
+{
+	WarmUpQueue.RemoveAll([WarmUpHandle](const FTireflyActorPoolWarmUpJob& Job)
+	{
+		return Job.Handle == WarmUpHandle;
+	});
+}
+
+float UTireflyActorPoolWorldSubsystem::GetWarmUpProgress(int32 WarmUpHandle) const
+{
+	if (WarmUpHandle <= 0 || WarmUpHandle >= NextWarmUpHandle)
+	{
+		return -1.f;
+	}
+
+	const FTireflyActorPoolWarmUpJob* Job = WarmUpQueue.FindByPredicate([WarmUpHandle](const FTireflyActorPoolWarmUpJob& Other)
+	{
+		return Other.Handle == WarmUpHandle;
+	});
+	if (!Job)
+	{
+		return 1.f;
+	}
+
+	return Job->TotalCount > 0 ? static_cast<float>(Job->ProcessedCount) / Job->TotalCount : 1.f;
+}
+
+bool UTireflyActorPoolWorldSubsystem::IsWarmUpInProgress(int32 WarmUpHandle) const
+{
+	return WarmUpQueue.ContainsByPredicate([WarmUpHandle](const FTireflyActorPoolWarmUpJob& Job)
+	{
+		return Job.Handle == WarmUpHandle;
+	});
+}
+
+int32 UTireflyActorPoolWorldSubsystem::GetPendingWarmUpActorCount() const
+{
+	int32 PendingCount = 0;
+	for (const FTireflyActorPoolWarmUpJob& Job : WarmUpQueue)
+	{
+		PendingCount += Job.TotalCount - Job.ProcessedCount;
+	}
+
+	return PendingCount;
+}
+
+void UTireflyActorPoolWorldSubsystem::SetWarmUpFrameBudget(float BudgetMs)
+{
+	WarmUpFrameBudgetMs = FMath::Max(BudgetMs, 0.f);
+}
+
+void UTireflyActorPoolWorldSubsystem::TickWarmUpQueue()
+{
+	TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(TickWarmUpQueue);
+
+	if (WarmUpQueue.IsEmpty())
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	if (!IsValid(World))
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double BudgetSeconds = WarmUpFrameBudgetMs / 1000.0;
+	const double CurrentTime = World->GetTimeSeconds();
+
+	TArray<FSimpleDelegate, TInlineAllocator<4>> CompletedDelegates;
+	bool bSpawnedAny = false;
+	while (!WarmUpQueue.IsEmpty())
+	{
+		FTireflyActorPoolWarmUpJob& Job = WarmUpQueue[0];
+		UClass* ActorClass = Job.ActorClass.Get();
+
+		const FTireflyActorPool* Pool = FindActorPool(ActorClass, Job.ActorId);
+		const bool bPoolFull = Pool && Pool->Policy.MaxIdleCount > 0 && Pool->ActorPool.Num() >= Pool->Policy.MaxIdleCount;
+		if (!ActorClass || bPoolFull || Job.ProcessedCount >= Job.TotalCount)
+		{
+			CompletedDelegates.Add(MoveTemp(Job.OnCompleted));
+			WarmUpQueue.RemoveAt(0);
+			continue;
+		}
+
+		// 每帧至少生成一个Actor，保证预算过小时预热也能推进
+		if (bSpawnedAny && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+		{
+			break;
+		}
+
+		++Job.ProcessedCount;
+		const FName ActorId = Job.ActorId;
+		bSpawnedAny = true;
+
+		// 生成Actor时可能会向队列中加入新任务，之后不能再使用Job引用
+		if (AActor* Actor = SpawnWarmUpActor_Internal(World, ActorClass, ActorId))
+		{
+			FTireflyActorPool& WarmUpPool = FindOrAddActorPool(ActorClass, ActorId);
+			WarmUpPool.PushIdleActor(Actor, CurrentTime);
+		}
+	}
+
+	for (const FSimpleDelegate& OnCompleted : CompletedDelegates)
+	{
+		OnCompleted.ExecuteIfBound();
+	}
+}
+
+int32 UTireflyActorPoolWorldSubsystem::SpawnActorFromPoolDeferred(
+	TSubclassOf<AActor> ActorClass,
+	FName ActorId,
+	const FTransform& Transform,
+	const FInstancedStruct& InitialData,
+	float Lifetime,
+	const ESpawnActorCollisionHandlingMethod CollisionHandling,
+	AActor* Owner,
+	APawn* Instigator,
+	int32 Priority,
+	bool bDroppable,
+	TFunction<void(AActor*)>&& OnSpawned)
+{
+	if (!IsInGameThread())
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Must be called on the game thread"), *FString(__FUNCTION__));
+		return INDEX_NONE;
+	}
+
+	UWorld* World = GetWorld();
+	if (!IsValid(World))
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid World"), *FString(__FUNCTION__));
+		return INDEX_NONE;
+	}
+
+	if (!IsValid(ActorClass))
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid ActorClass"), *FString(__FUNCTION__));
+		return INDEX_NONE;
+	}
+
+	if (!FTireflyPoolingActorDispatch::Implements(ActorClass))
+	{
+		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] ActorClass %s does not implement UTireflyPoolingActorInterface"),
+			*FString(__FUNCTION__),
+			*ActorClass->GetName());
+		return INDEX_NONE;
+	}
+
+	// 命中待命Actor不受预算限制，立即生成
+	const int32 PoolIndex = FindOrAddActorPoolIndex(ActorClass, ActorId);
+	if (!ActorPools[PoolIndex].ActorPool.IsEmpty() || HasColdSpawnBudget())
+	{
+		TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(SpawnActor);
+
+		AActor* Actor = SpawnActorFromPoolIndex_Internal(
+			World,
+			ActorClass,
+			ActorId,
+			PoolIndex,
+			Transform,
+			InitialData.IsValid() ? &InitialData : nullptr,
+			Lifetime,
+			CollisionHandling,
+			Owner,
+			Instigator);
+		if (OnSpawned)
+		{
+			OnSpawned(Actor);
+		}
+		return INDEX_NONE;
+	}
+
+	if (bDroppable && DeferredSpawnDropTimeout <= 0.f)
+	{
+		TIREFLY_ACTOR_POOL_INC_COUNTER(DroppedSpawns, 1);
+		if (OnSpawned)
+		{
+			OnSpawned(nullptr);
+		}
+		return INDEX_NONE;
+	}
+
+	FTireflyActorPoolDeferredSpawn Request;
+	Request.Handle = NextDeferredSpawnHandle++;
+	Request.ActorClass = ActorClass.Get();
+	Request.ActorId = ActorId;
+	Request.Transform = Transform;
+	Request.InitialData = InitialData;
+	Request.Lifetime = Lifetime;
+	Request.CollisionHandling = CollisionHandling;
+	Request.Owner = Owner;
+	Request.Instigator = Instigator;
+	Request.Priority = Priority;
+	Request.bDroppable = bDroppable;
+	Request.RequestTime = GetPoolTime();
+	Request.OnSpawned = MoveTemp(OnSpawned);
+
+	const int32 Handle = Request.Handle;
+	TireflyActorPool::InsertDeferredSpawn(DeferredSpawnQueue, MoveTemp(Request));
+	TIREFLY_ACTOR_POOL_INC_COUNTER(DeferredSpawns, 1);
+
+	return Handle;
+}
+
+void UTireflyActorPoolWorldSubsystem::CancelDeferredSpawn(int32 DeferredSpawnHandle)
+{
+	DeferredSpawnQueue.RemoveAll([DeferredSpawnHandle](const FTireflyActorPoolDeferredSpawn& Request)
+	{
+		return Request.Handle == DeferredSpawnHandle;
+	});
+}
+
+bool UTireflyActorPoolWorldSubsystem::IsDeferredSpawnPending(int32 DeferredSpawnHandle) const
+{
+	return DeferredSpawnQueue.ContainsByPredicate([DeferredSpawnHandle](const FTireflyActorPoolDeferredSpawn& Request)
+	{
+		return Request.Handle == DeferredSpawnHandle;
+	});
+}
+
+void UTireflyActorPoolWorldSubsystem::SetColdSpawnFrameBudget(int32 BudgetCount, float BudgetMs)
+{
+	ColdSpawnFrameBudgetCount = FMath::Max(BudgetCount, 0);
+	ColdSpawnFrameBudgetMs = FMath::Max(BudgetMs, 0.f);
+}
+
+bool UTireflyActorPoolWorldSubsystem::HasColdSpawnBudget() const
+{
+	if (ColdSpawnFrameBudgetCount > 0 && ColdSpawnsThisFrame >= ColdSpawnFrameBudgetCount)
+	{
+		return false;
+	}
+
+	if (ColdSpawnFrameBudgetMs > 0.f && ColdSpawnSecondsThisFrame * 1000.0 >= ColdSpawnFrameBudgetMs)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+void UTireflyActorPoolWorldSubsystem::TickDeferredSpawnQueue()
+{
+	TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(TickDeferredSpawnQueue);
+
+	if (DeferredSpawnQueue.IsEmpty())
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	if (!IsValid(World))
+	{
+		return;
+	}
+
+	const double CurrentTime = GetPoolTime();
+
+	// 取出整个队列处理，生成过程中新提交的请求会进入新的队列，处理完后再合并
+	TArray<FTireflyActorPoolDeferredSpawn> Requests = MoveTemp(DeferredSpawnQueue);
+	DeferredSpawnQueue.Reset();
+
+	TArray<FTireflyActorPoolDeferredSpawn> RemainingRequests;
+	TArray<TPair<TFunction<void(AActor*)>, TWeakObjectPtr<AActor>>> CompletedCallbacks;
+	bool bSpawnedNew = false;
+	for (FTireflyActorPoolDeferredSpawn& Request : Requests)
+	{
+		UClass* ActorClass = Request.ActorClass.Get();
+		if (!ActorClass || Request.Owner.IsStale() || Request.Instigator.IsStale())
+		{
+			CompletedCallbacks.Emplace(MoveTemp(Request.OnSpawned), nullptr);
+			continue;
+		}
+
+		// 命中待命Actor不受预算限制；每帧至少即时生成一个Actor，保证其他即时生成占满预算时队列也能推进
+		const int32 PoolIndex = FindOrAddActorPoolIndex(ActorClass, Request.ActorId);
+		const bool bHit = !ActorPools[PoolIndex].ActorPool.IsEmpty();
+		if (bHit || !bSpawnedNew || HasColdSpawnBudget())
+		{
+			bSpawnedNew |= !bHit;
+			AActor* Actor = SpawnActorFromPoolIndex_Internal(
+				World,
+				ActorClass,
+				Request.ActorId,
+				PoolIndex,
+				Request.Transform,
+				Request.InitialData.IsValid() ? &Request.InitialData : nullptr,
+				Request.Lifetime,
+				Request.CollisionHandling,
+				Request.Owner.Get(),
+				Request.Instigator.Get());
+			CompletedCallbacks.Emplace(MoveTemp(Request.OnSpawned), Actor);
+			continue;
+		}
+
+		if (Request.bDroppable && Request.RequestTime + DeferredSpawnDropTimeout <= CurrentTime)
+		{
+			TIREFLY_ACTOR_POOL_INC_COUNTER(DroppedSpawns, 1);
+			CompletedCallbacks.Emplace(MoveTemp(Request.OnSpawned), nullptr);
+			continue;
+		}
+
+		RemainingRequests.Add(MoveTemp(Request));
+	}
+
+	// 处理过程中新提交的请求排在相同优先级的旧请求之后
+	for (FTireflyActorPoolDeferredSpawn& Request : DeferredSpawnQueue)
+	{
+		TireflyActorPool::InsertDeferredSpawn(RemainingRequests, MoveTemp(Request));
+	}
+	DeferredSpawnQueue = MoveTemp(RemainingRequests);
+
+	for (const auto& Completed : CompletedCallbacks)
+	{
+		if (Completed.Key)
+		{
+			Completed.Key(Completed.Value.Get());
+		}
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::LoadActorClassAsync(const TSoftClassPtr<AActor>& ActorClass, TFunction<void(UClass*)>&& OnLoaded)
+{
+	if (ActorClass.IsNull())
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Invalid ActorClass"), *FString(__FUNCTION__));
+		if (OnLoaded)
+		{
+			OnLoaded(nullptr);
+		}
+		return;
+	}
+
+	if (UClass* LoadedClass = ActorClass.Get())
+	{
+		if (OnLoaded)
+		{
+			OnLoaded(LoadedClass);
+		}
+		return;
+	}
+
+	const FSoftObjectPath ClassPath = ActorClass.ToSoftObjectPath();
+	TSharedPtr<FStreamableHandle> LoadHandle = StreamableManager.RequestAsyncLoad(
+		ClassPath,
+		FStreamableDelegate::CreateWeakLambda(this, [ActorClass, OnLoaded = MoveTemp(OnLoaded)]()
+		{
+			UClass* LoadedClass = ActorClass.Get();
+			if (!LoadedClass)
+			{
+				UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Failed to load ActorClass %s"),
+					*FString(__FUNCTION__),
+					*ActorClass.ToString());
+			}
+
+			if (OnLoaded)
+			{
+				OnLoaded(LoadedClass);
+			}
+		}));
+
+	if (LoadHandle.IsValid())
+	{
+		ActorClassLoadHandles.Add(ClassPath, MoveTemp(LoadHandle));
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::WarmUpActorPoolAsync(
+	const TSoftClassPtr<AActor>& ActorClass,
+	FName ActorId,
+	int32 Count,
+	int32 Priority,
+	TFunction<void(bool)>&& OnCompleted)
+{
+	LoadActorClassAsync(ActorClass, [this, ActorId, Count, Priority, OnCompleted = MoveTemp(OnCompleted)](UClass* LoadedClass)
+	{
+		FSimpleDelegate OnWarmUpCompleted;
+		if (OnCompleted)
+		{
+			OnWarmUpCompleted.BindWeakLambda(this, [OnCompleted]()
+			{
+				OnCompleted(true);
+			});
+		}
+
+		if (!LoadedClass || QueueWarmUpActorPool(LoadedClass, ActorId, Count, Priority, MoveTemp(OnWarmUpCompleted)) == INDEX_NONE)
+		{
+			if (OnCompleted)
+			{
+				OnCompleted(false);
+			}
+		}
+	});
+}
+
+void UTireflyActorPoolWorldSubsystem::SpawnActorFromPoolAsync(
+	const TSoftClassPtr<AActor>& ActorClass,
+	FName ActorId,
+	const FTransform& Transform,
+	const FInstancedStruct& InitialData,
+	float Lifetime,
+	const ESpawnActorCollisionHandlingMethod CollisionHandling,
+	AActor* Owner,
+	APawn* Instigator,
+	TFunction<void(AActor*)>&& OnSpawned)
+{
+	TWeakObjectPtr<AActor> WeakOwner = Owner;
+	TWeakObjectPtr<APawn> WeakInstigator = Instigator;
+
+	LoadActorClassAsync(ActorClass, [this, ActorId, Transform, InitialData, Lifetime, CollisionHandling, WeakOwner, WeakInstigator, OnSpawned = MoveTemp(OnSpawned)](UClass* LoadedClass)
+	{
+		AActor* Actor = nullptr;
+		if (LoadedClass)
+		{
+			Actor = SpawnActor_Internal(
+				LoadedClass,
+				ActorId,
+				Transform,
+				InitialData.IsValid() ? &InitialData : nullptr,
+				Lifetime,
+				CollisionHandling,
+				WeakOwner.Get(),
+				WeakInstigator.Get());
+		}
+
+		if (OnSpawned)
+		{
+			OnSpawned(Actor);
+		}
+	});
+}
+
+void UTireflyActorPoolWorldSubsystem::ReserveActorPools(const UObject* ReservationOwner, const UTireflyActorPoolConfig* Config)
+{
+	if (!IsValid(Config))
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Invalid Config"), *FString(__FUNCTION__));
+		return;
+	}
+
+	ReserveActorPoolEntries(ReservationOwner, Config->PoolEntries);
+}
+
+void UTireflyActorPoolWorldSubsystem::ReserveActorPoolEntries(const UObject* ReservationOwner, TConstArrayView<FTireflyActorPoolConfigEntry> Entries)
+{
+	if (!ReservationOwner)
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Invalid ReservationOwner"), *FString(__FUNCTION__));
+		return;
+	}
+
+	// 重复保留时先释放之前的保留，同一内容的保留数量不会累加
+	const FObjectKey OwnerKey(ReservationOwner);
+	ReleaseActorPoolReservations(OwnerKey);
+
+	TArray<FTireflyActorPoolConfigEntry> PolicyEntries;
+	TArray<FTireflyActorPoolReservation>& Reservations = ActorPoolReservations.FindOrAdd(OwnerKey);
+	for (const FTireflyActorPoolConfigEntry& Entry : Entries)
+	{
+		if (Entry.ActorClass.IsNull())
+		{
+			UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Config entry %s has no ActorClass"),
+				*FString(__FUNCTION__),
+				*Entry.ActorId.ToString());
+			continue;
+		}
+
+		FTireflyActorPoolReservation& Reservation = Reservations.AddDefaulted_GetRef();
+		Reservation.ReservationId = NextReservationId++;
+		Reservation.ActorClass = Entry.ActorClass;
+		Reservation.ActorId = Entry.ActorId;
+		Reservation.Count = FMath::Max(Entry.WarmUpCount, 0);
+		Reservation.WarmUpPriority = Entry.WarmUpPriority;
+
+		// 策略覆盖沿用配置的应用方式，预热由保留自己完成
+		if (Entry.bOverridePolicy)
+		{
+			FTireflyActorPoolConfigEntry& PolicyEntry = PolicyEntries.Add_GetRef(Entry);
+			PolicyEntry.WarmUpCount = 0;
+		}
+	}
+
+	ApplyActorPoolConfigEntries(PolicyEntries);
+
+	// Actor类型已加载时会立即回调，回调中不会增删保留，但仍按标识逐个加载以免引用失效
+	TArray<TPair<int32, TSoftClassPtr<AActor>>> PendingLoads;
+	for (const FTireflyActorPoolReservation& Reservation : Reservations)
+	{
+		PendingLoads.Emplace(Reservation.ReservationId, Reservation.ActorClass);
+	}
+
+	for (const auto& PendingLoad : PendingLoads)
+	{
+		const int32 ReservationId = PendingLoad.Key;
+		LoadActorClassAsync(PendingLoad.Value, [this, OwnerKey, ReservationId](UClass* LoadedClass)
+		{
+			if (LoadedClass)
+			{
+				ApplyActorPoolReservation(OwnerKey, ReservationId, LoadedClass);
+			}
+		});
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::ReleaseActorPoolReservations(const UObject* ReservationOwner)
+{
+	ReleaseActorPoolReservations(FObjectKey(ReservationOwner));
+}
+
+void UTireflyActorPoolWorldSubsystem::ReleaseActorPoolReservations(FObjectKey ReservationOwner)
+{
+	TArray<FTireflyActorPoolReservation> Reservations;
+	if (!ActorPoolReservations.RemoveAndCopyValue(ReservationOwner, Reservations))
+	{
+		return;
+	}
+
+	for (const FTireflyActorPoolReservation& Reservation : Reservations)
+	{
+		if (Reservation.WarmUpHandle != INDEX_NONE)
+		{
+			CancelWarmUp(Reservation.WarmUpHandle);
+		}
+
+		// 对象池已被清理，或Actor类型还没有加载完成
+		const int32 PoolIndex = ResolveActorPoolIndex(Reservation.PoolKey);
+		if (PoolIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		FTireflyActorPool& Pool = ActorPools[PoolIndex];
+		Pool.ReservedCount = FMath::Max(Pool.ReservedCount - Reservation.Count, 0);
+		Pool.PendingReleaseCount += Reservation.Count;
+	}
+}
+
+bool UTireflyActorPoolWorldSubsystem::HasActorPoolReservations(const UObject* ReservationOwner) const
+{
+	return ActorPoolReservations.Contains(FObjectKey(ReservationOwner));
+}
+
+void UTireflyActorPoolWorldSubsystem::ApplyActorPoolReservation(FObjectKey ReservationOwner, int32 ReservationId, UClass* LoadedClass)
+{
+	// 保留可能在Actor类型加载完成前已经被释放
+	TArray<FTireflyActorPoolReservation>* Reservations = ActorPoolReservations.Find(ReservationOwner);
+	FTireflyActorPoolReservation* Reservation = Reservations
+		? Reservations->FindByPredicate([ReservationId](const FTireflyActorPoolReservation& Other) { return Other.ReservationId == ReservationId; })
+		: nullptr;
+	if (!Reservation || Reservation->PoolKey.IsSet())
+	{
+		return;
+	}
+
+	if (!FTireflyPoolingActorDispatch::Implements(LoadedClass))
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] ActorClass %s does not implement UTireflyPoolingActorInterface"),
+			*FString(__FUNCTION__),
+			*LoadedClass->GetName());
+		return;
+	}
+
+	const int32 PoolIndex = FindOrAddActorPoolIndex(LoadedClass, Reservation->ActorId);
+	FTireflyActorPool& Pool = ActorPools[PoolIndex];
+	Pool.ReservedCount += Reservation->Count;
+
+	// 内容卸载后很快又重新加载时，直接保留尚未销毁的待命Actor
+	Pool.PendingReleaseCount = FMath::Max(Pool.PendingReleaseCount - Reservation->Count, 0);
+	Reservation->PoolKey = MakeActorPoolKey(PoolIndex);
+
+	// 只预热对象池中还缺少的部分，已经排队的预热也计算在内
+	const int32 MissingCount = Pool.ReservedCount - Pool.ActorPool.Num() - GetPendingWarmUpActorCountOfPool(LoadedClass, Reservation->ActorId);
+	if (MissingCount > 0)
+	{
+		Reservation->WarmUpHandle = QueueWarmUpActorPool(
+			LoadedClass,
+			Reservation->ActorId,
+			FMath::Min(MissingCount, Reservation->Count),
+			Reservation->WarmUpPriority);
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::TickStreamingLevelReservations()
+{
+	if (StreamingLevelPoolConfigs.IsEmpty())
+	{
+		return;
+	}
+
+	const UWorld* World = GetWorld();
+	if (!IsValid(World))
+	{
+		return;
+	}
+
+	// 不再需要加载（或已经被移除）的流送关卡释放保留
+	for (int32 Index = ReservedStreamingLevels.Num() - 1; Index >= 0; --Index)
+	{
+		const ULevelStreaming* StreamingLevel = Cast<ULevelStreaming>(ReservedStreamingLevels[Index].ResolveObjectPtr());
+		if (!StreamingLevel || !StreamingLevel->ShouldBeLoaded())
+		{
+			ReleaseActorPoolReservations(ReservedStreamingLevels[Index]);
+			ReservedStreamingLevels.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		}
+	}
+
+	// 关卡一开始请求加载就保留对象池，让预热与关卡的流送同时进行
+	for (const ULevelStreaming* StreamingLevel : World->GetStreamingLevels())
+	{
+		if (!StreamingLevel || !StreamingLevel->ShouldBeLoaded())
+		{
+			continue;
+		}
+
+		const TSoftObjectPtr<UTireflyActorPoolConfig>* Config = StreamingLevelPoolConfigs.Find(StreamingLevel->GetWorldAssetPackageFName());
+		const FObjectKey LevelKey(StreamingLevel);
+		if (!Config || ReservedStreamingLevels.Contains(LevelKey))
+		{
+			continue;
+		}
+
+		// 配置仍在异步加载时留到之后的Tick处理
+		const UTireflyActorPoolConfig* LoadedConfig = Config->Get();
+		if (!LoadedConfig)
+		{
+			continue;
+		}
+
+		ReservedStreamingLevels.Add(LevelKey);
+		ReserveActorPools(StreamingLevel, LoadedConfig);
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::BindDataLayerReservations(UWorld& InWorld)
+{
+	if (GetDefault<UTireflyActorPoolSettings>()->DataLayerPoolConfigs.IsEmpty())
+	{
+		return;
+	}
+
+	UDataLayerManager* DataLayerManager = UDataLayerManager::GetDataLayerManager(&InWorld);
+	if (!DataLayerManager)
+	{
+		return;
+	}
+
+	DataLayerManager->OnDataLayerInstanceRuntimeStateChanged.AddUniqueDynamic(this, &UTireflyActorPoolWorldSubsystem::HandleDataLayerRuntimeStateChanged);
+
+	// 世界开始运行前已经加载的数据层不会再触发状态变化
+	DataLayerManager->ForEachDataLayerInstance([this](UDataLayerInstance* DataLayer)
+	{
+		HandleDataLayerRuntimeStateChanged(DataLayer, DataLayer->GetEffectiveRuntimeState());
+		return true;
+	});
+}
+
+void UTireflyActorPoolWorldSubsystem::HandleDataLayerRuntimeStateChanged(const UDataLayerInstance* DataLayer, EDataLayerRuntimeState State)
+{
+	const UDataLayerAsset* DataLayerAsset = DataLayer ? DataLayer->GetAsset() : nullptr;
+	if (!DataLayerAsset)
+	{
+		return;
+	}
+
+	const TSoftObjectPtr<UTireflyActorPoolConfig>* Config = GetDefault<UTireflyActorPoolSettings>()->DataLayerPoolConfigs.Find(
+		TSoftObjectPtr<UDataLayerAsset>(FSoftObjectPath(DataLayerAsset)));
+	if (!Config)
+	{
+		return;
+	}
+
+	if (State == EDataLayerRuntimeState::Unloaded)
+	{
+		ReleaseActorPoolReservations(DataLayer);
+	}
+	else if (!HasActorPoolReservations(DataLayer))
+	{
+		// 配置仍在异步加载时，由加载完成的回调补上保留
+		if (const UTireflyActorPoolConfig* LoadedConfig = Config->Get())
+		{
+			ReserveActorPools(DataLayer, LoadedConfig);
+		}
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::LoadReservationConfigs()
+{
+	TArray<FSoftObjectPath> ConfigPaths;
+	for (const auto& LevelConfig : StreamingLevelPoolConfigs)
+	{
+		if (!LevelConfig.Value.IsNull())
+		{
+			ConfigPaths.AddUnique(LevelConfig.Value.ToSoftObjectPath());
+		}
+	}
+
+	for (const auto& LayerConfig : GetDefault<UTireflyActorPoolSettings>()->DataLayerPoolConfigs)
+	{
+		if (!LayerConfig.Value.IsNull())
+		{
+			ConfigPaths.AddUnique(LayerConfig.Value.ToSoftObjectPath());
+		}
+	}
+
+	if (ConfigPaths.IsEmpty())
+	{
+		return;
+	}
+
+	ReservationConfigsHandle = StreamableManager.RequestAsyncLoad(
+		MoveTemp(ConfigPaths),
+		FStreamableDelegate::CreateUObject(this, &UTireflyActorPoolWorldSubsystem::HandleReservationConfigsLoaded));
+}
+
+void UTireflyActorPoolWorldSubsystem::HandleReservationConfigsLoaded()
+{
+	UDataLayerManager* DataLayerManager = UDataLayerManager::GetDataLayerManager(GetWorld());
+	if (!DataLayerManager)
+	{
+		return;
+	}
+
+	// 已经持有保留或已卸载的数据层不受影响
+	DataLayerManager->ForEachDataLayerInstance([this](UDataLayerInstance* DataLayer)
+	{
+		HandleDataLayerRuntimeStateChanged(DataLayer, DataLayer->GetEffectiveRuntimeState());
+		return true;
+	});
+}
+
+void UTireflyActorPoolWorldSubsystem::ApplyActorPoolConfig(const UTireflyActorPoolConfig* Config)
+{
+	if (!IsValid(Config))
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Invalid Config"), *FString(__FUNCTION__));
+		return;
+	}
+
+	ApplyActorPoolConfigEntries(Config->PoolEntries);
+}
+
+void UTireflyActorPoolWorldSubsystem::ApplyActorPoolConfigEntries(TConstArrayView<FTireflyActorPoolConfigEntry> Entries)
+{
+	for (const FTireflyActorPoolConfigEntry& Entry : Entries)
+	{
+		if (Entry.ActorClass.IsNull())
+		{
+			UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Config entry %s has no ActorClass"),
+				*FString(__FUNCTION__),
+				*Entry.ActorId.ToString());
+			continue;
+		}
+
+		// 策略不依赖Actor类型是否已加载，可以立即应用
+		if (Entry.bOverridePolicy)
+		{
+			if (Entry.ActorId != NAME_None)
+			{
+				SetActorPoolPolicyOfId(Entry.ActorId, Entry.Policy);
+			}
+			else if (UClass* LoadedClass = Entry.ActorClass.Get())
+			{
+				SetActorPoolPolicyOfClass(LoadedClass, Entry.Policy);
+			}
+		}
+
+		const bool bPendingClassPolicy = Entry.bOverridePolicy && Entry.ActorId == NAME_None && !Entry.ActorClass.Get();
+		if (Entry.WarmUpCount <= 0 && !bPendingClassPolicy)
+		{
+			continue;
+		}
+
+		LoadActorClassAsync(Entry.ActorClass, [this, Entry, bPendingClassPolicy](UClass* LoadedClass)
+		{
+			if (!LoadedClass)
+			{
+				return;
+			}
+
+			if (bPendingClassPolicy)
+			{
+				SetActorPoolPolicyOfClass(LoadedClass, Entry.Policy);
+			}
 
-	Super::Deinitialize();
+			if (Entry.WarmUpCount > 0)
+			{
+				QueueWarmUpActorPool(LoadedClass, Entry.ActorId, Entry.WarmUpCount, Entry.WarmUpPriority);
+			}
+		});
+	}
 }
 
-void UTireflyActorPoolWorldSubsystem::ClearAllActorPools()
+void UTireflyActorPoolWorldSubsystem::GatherActorPoolConfigs(const UWorld& InWorld, TArray<TSoftObjectPtr<UTireflyActorPoolConfig>>& OutConfigs) const
 {
-	FScopeLock Lock(&PoolLock);
-	
-	// 批量处理Class池
-	for (auto& Pool : ActorPoolOfClass)
+	const UTireflyActorPoolSettings* Settings = GetDefault<UTireflyActorPoolSettings>();
+
+	auto AppendConfig = [&OutConfigs](const TSoftObjectPtr<UTireflyActorPoolConfig>& ConfigPtr)
 	{
-		for (auto Actor : Pool.Value.ActorPool)
+		if (!ConfigPtr.IsNull())
 		{
-			if (IsValid(Actor))
-			{
-				Actor->Destroy(true);
-			}
+			OutConfigs.Add(ConfigPtr);
 		}
-	}
+	};
+
+	AppendConfig(Settings->DefaultPoolConfig);
 
-	for (auto Pool : ActorPoolOfId)
+	const FString MapPackageName = GetMapPackageName(InWorld);
+	for (const auto& MapConfig : Settings->MapPoolConfigs)
 	{
-		for (auto Actor : Pool.Value.ActorPool)
+		if (MapConfig.Key.ToSoftObjectPath().GetLongPackageName() == MapPackageName)
 		{
-			if (IsValid(Actor))
-			{
-				Actor->Destroy(true);
-			}
+			AppendConfig(MapConfig.Value);
+			break;
 		}
 	}
 
-	ActorPoolOfClass.Empty();
-	ActorPoolOfId.Empty();
-}
+	// 客户端没有GameMode实例，通过GameState获取游戏模式类型
+	const UClass* GameModeClass = nullptr;
+	if (const AGameModeBase* GameMode = InWorld.GetAuthGameMode())
+	{
+		GameModeClass = GameMode->GetClass();
+	}
+	else if (const AGameStateBase* GameState = InWorld.GetGameState())
+	{
+		GameModeClass = GameState->GameModeClass;
+	}
 
-void UTireflyActorPoolWorldSubsystem::ClearActorPoolsOfClass(TSubclassOf<AActor> ActorClass)
-{
-	if (FTireflyActorPool* Pool = ActorPoolOfClass.Find(ActorClass))
+	// 从游戏模式类型开始向父类查找，使用最接近的配置
+	for (const UClass* Class = GameModeClass; Class && Class != AGameModeBase::StaticClass()->GetSuperClass(); Class = Class->GetSuperClass())
 	{
-		for (auto Actor : Pool->ActorPool)
+		if (const TSoftObjectPtr<UTireflyActorPoolConfig>* GameModeConfig = Settings->GameModePoolConfigs.Find(TSoftClassPtr<AGameModeBase>(FSoftObjectPath(Class))))
 		{
-			if (IsValid(Actor))
-			{
-				Actor->Destroy(true);
-			}
+			AppendConfig(*GameModeConfig);
+			break;
 		}
-		Pool->ActorPool.Empty();
-		ActorPoolOfClass.Remove(ActorClass);
 	}
 }
 
-void UTireflyActorPoolWorldSubsystem::ClearActorPoolOfId(FName ActorId)
+void UTireflyActorPoolWorldSubsystem::LoadWorldPoolConfigs(const UWorld& InWorld)
+{
+	WorldPoolConfigs.Reset();
+	GatherActorPoolConfigs(InWorld, WorldPoolConfigs);
+
+	TArray<FSoftObjectPath> ConfigPaths;
+	for (const TSoftObjectPtr<UTireflyActorPoolConfig>& ConfigPtr : WorldPoolConfigs)
+	{
+		ConfigPaths.AddUnique(ConfigPtr.ToSoftObjectPath());
+	}
+
+	if (ConfigPaths.IsEmpty())
+	{
+		HandleWorldPoolConfigsLoaded();
+		return;
+	}
+
+	WorldPoolConfigsHandle = StreamableManager.RequestAsyncLoad(
+		MoveTemp(ConfigPaths),
+		FStreamableDelegate::CreateUObject(this, &UTireflyActorPoolWorldSubsystem::HandleWorldPoolConfigsLoaded));
+}
+
+void UTireflyActorPoolWorldSubsystem::HandleWorldPoolConfigsLoaded()
 {
-	if (FTireflyActorPool* Pool = ActorPoolOfId.Find(ActorId))
+	TArray<FTireflyActorPoolConfigEntry> ConfigEntries;
+	for (const TSoftObjectPtr<UTireflyActorPoolConfig>& ConfigPtr : WorldPoolConfigs)
 	{
-		for (auto Actor : Pool->ActorPool)
+		const UTireflyActorPoolConfig* Config = ConfigPtr.Get();
+		if (!Config)
 		{
-			if (IsValid(Actor))
+			UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Failed to load pool config %s"),
+				*FString(__FUNCTION__),
+				*ConfigPtr.ToString());
+			continue;
+		}
+
+		for (const FTireflyActorPoolConfigEntry& Entry : Config->PoolEntries)
+		{
+			// 后应用的配置覆盖先应用的配置中针对同一对象池的条目
+			const int32 ExistingIndex = ConfigEntries.IndexOfByPredicate([&Entry](const FTireflyActorPoolConfigEntry& Other)
 			{
-				Actor->Destroy(true);
+				return Other.IsSamePool(Entry);
+			});
+			if (ExistingIndex != INDEX_NONE)
+			{
+				ConfigEntries[ExistingIndex] = Entry;
+			}
+			else
+			{
+				ConfigEntries.Add(Entry);
 			}
 		}
-		Pool->ActorPool.Empty();
-		ActorPoolOfId.Remove(ActorId);
 	}
-}
 
-AActor* UTireflyActorPoolWorldSubsystem::FetchActorFromPool(const TSubclassOf<AActor>& ActorClass, FName ActorId)
-{
-	if (!ActorClass)
+	// 条目已经复制出来，配置资产不需要继续常驻
+	WorldPoolConfigs.Empty();
+	if (WorldPoolConfigsHandle.IsValid())
 	{
-		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid ActorClass"), *FString(__FUNCTION__));
-		return nullptr;
+		WorldPoolConfigsHandle->ReleaseHandle();
+		WorldPoolConfigsHandle.Reset();
 	}
 
-	if (FTireflyActorPool* Pool = (ActorId != NAME_None) ? ActorPoolOfId.Find(ActorId) : ActorPoolOfClass.Find(ActorClass))
+	ApplyActorPoolConfigEntries(ConfigEntries);
+
+	const UWorld* World = GetWorld();
+	if (IsValid(World) && GetDefault<UTireflyActorPoolSettings>()->bApplyUsageManifest)
 	{
-		return Pool->ActorPool.IsEmpty() ? nullptr : Pool->ActorPool.Pop();
+		ApplyActorPoolUsageManifest(*World);
 	}
-
-	return nullptr;
 }
 
-AActor* UTireflyActorPoolWorldSubsystem::SpawnActor_Internal(
-	const TSubclassOf<AActor>& ActorClass,
-	FName ActorId,
-	const FTransform& Transform,
-	const FInstancedStruct* InitialData,
-	float Lifetime,
-	const ESpawnActorCollisionHandlingMethod CollisionHandling,
-	AActor* Owner,
-	APawn* Instigator)
+bool UTireflyActorPoolWorldSubsystem::SaveActorPoolUsageManifest()
 {
-	UWorld* World = GetWorld();
+	const UWorld* World = GetWorld();
 	if (!IsValid(World))
 	{
 		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid World"), *FString(__FUNCTION__));
-		return nullptr;
+		return false;
 	}
 
-	if (!IsValid(ActorClass))
+	FTireflyActorPoolManifest Manifest;
+	Manifest.MapPackageName = GetMapPackageName(*World);
+
+	auto AppendPool = [&Manifest](const FTireflyActorPool& Pool, FName ActorId)
 	{
-		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid ActorClass"), *FString(__FUNCTION__));
-		return nullptr;
+		// 从未被请求过的对象池（例如只做过预热）没有可记录的使用情况
+		if (!Pool.ActorClass || Pool.FirstDemandTime < 0.0)
+		{
+			return;
+		}
+
+		FTireflyActorPoolManifestEntry& Entry = Manifest.Entries.AddDefaulted_GetRef();
+		Entry.ActorClass = FSoftClassPath(Pool.ActorClass.Get());
+		Entry.ActorId = ActorId;
+		Entry.PeakActiveCount = Pool.PeakActiveCount;
+		Entry.MissCount = Pool.MissCount;
+		Entry.FirstDemandTime = static_cast<float>(Pool.FirstDemandTime);
+	};
+
+	for (const auto& PoolEntry : ActorPoolIndexOfClass)
+	{
+		AppendPool(ActorPools[PoolEntry.Value], NAME_None);
 	}
 
-	if (!ActorClass->ImplementsInterface(UTireflyPoolingActorInterface::StaticClass()))
+	for (const auto& PoolEntry : ActorPoolIndexOfId)
 	{
-		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] ActorClass %s does not implement UTireflyPoolingActorInterface"),
-			*FString(__FUNCTION__),
-			*ActorClass->GetName());
-		return nullptr;
+		AppendPool(ActorPools[PoolEntry.Value], PoolEntry.Key);
 	}
 
-	FScopeLock Lock(&PoolLock);
+	const FString FilePath = FTireflyActorPoolManifest::GetManifestFilePath(Manifest.MapPackageName);
 
-	AActor* Actor = FetchActorFromPool(ActorClass, ActorId);
-	if (Actor)
+	FTireflyActorPoolManifest ExistingManifest;
+	if (ExistingManifest.LoadFromFile(FilePath))
 	{
-		Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
-		Actor->SetInstigator(Instigator);
-		Actor->SetOwner(Owner);
+		Manifest.Merge(ExistingManifest);
 	}
-	else
+
+	if (!Manifest.SaveToFile(FilePath))
 	{
-		FActorSpawnParameters SpawnParameters;
-		SpawnParameters.Owner = Owner;
-		SpawnParameters.Instigator = Instigator;
-		SpawnParameters.SpawnCollisionHandlingOverride = CollisionHandling;
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Failed to write usage manifest %s"), *FString(__FUNCTION__), *FilePath);
+		return false;
+	}
 
-		Actor = World->SpawnActor<AActor>(ActorClass, Transform, SpawnParameters);
-		if (!IsValid(Actor))
+	UE_LOG(LogTireflyActorPool, Log, TEXT("[%s] Wrote %d pool entries to usage manifest %s"),
+		*FString(__FUNCTION__),
+		Manifest.Entries.Num(),
+		*FilePath);
+	return true;
+}
+
+void UTireflyActorPoolWorldSubsystem::ApplyActorPoolUsageManifest(const UWorld& InWorld)
+{
+	FTireflyActorPoolManifest Manifest;
+	if (!Manifest.LoadFromFile(FTireflyActorPoolManifest::GetManifestFilePath(GetMapPackageName(InWorld))))
+	{
+		return;
+	}
+
+	// 越早被请求的对象池越先预热
+	Manifest.Entries.StableSort([](const FTireflyActorPoolManifestEntry& A, const FTireflyActorPoolManifestEntry& B)
+	{
+		return A.FirstDemandTime < B.FirstDemandTime;
+	});
+
+	const int32 BasePriority = GetDefault<UTireflyActorPoolSettings>()->UsageManifestWarmUpPriority;
+	for (int32 Rank = 0; Rank < Manifest.Entries.Num(); ++Rank)
+	{
+		const FTireflyActorPoolManifestEntry& Entry = Manifest.Entries[Rank];
+		if (Entry.PeakActiveCount <= 0 || Entry.ActorClass.IsNull())
 		{
-			UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Failed to spawn ActorClass %s"),
-				*FString(__FUNCTION__),
-				*ActorClass->GetName());
-			return nullptr;
+			continue;
 		}
 
-		if (ActorId != NAME_None)
+		const FName ActorId = Entry.ActorId;
+		const int32 PeakCount = Entry.PeakActiveCount;
+		const int32 Priority = BasePriority - Rank;
+		LoadActorClassAsync(TSoftClassPtr<AActor>(Entry.ActorClass), [this, ActorId, PeakCount, Priority](UClass* LoadedClass)
 		{
-			ITireflyPoolingActorInterface::Execute_PoolingSetActorId(Actor, ActorId);
-		}
-	}
+			if (!LoadedClass)
+			{
+				return;
+			}
 
-	ITireflyPoolingActorInterface::Execute_PoolingBeginPlay(Actor);
-	if (InitialData)
-	{
-		ITireflyPoolingActorInterface::Execute_PoolingInitialized(Actor, *InitialData);
+			// 只补足对象池中还缺少的部分，对象池配置等已经排队的预热也计算在内
+			const FTireflyActorPool* Pool = FindActorPool(LoadedClass, ActorId);
+			const int32 MissingCount = PeakCount - (Pool ? Pool->ActorPool.Num() : 0) - GetPendingWarmUpActorCountOfPool(LoadedClass, ActorId);
+			if (MissingCount > 0)
+			{
+				QueueWarmUpActorPool(LoadedClass, ActorId, MissingCount, Priority);
+			}
+		});
 	}
+}
 
-	if (Lifetime > 0.f)
-	{		
-		FTimerHandle TimerHandle;
-		FTimerDelegate TimerDelegate = FTimerDelegate::CreateLambda(
-			[this, Actor]
-			{
-				RecycleActorToPool(Actor);
-				ActorLifetimeTimers.Remove(Actor);
-			});
-		World->GetTimerManager().SetTimer(TimerHandle, TimerDelegate, Lifetime, false);
-		ActorLifetimeTimers.Add(Actor, TimerHandle);
+int32 UTireflyActorPoolWorldSubsystem::GetPendingWarmUpActorCountOfPool(const UClass* ActorClass, FName ActorId) const
+{
+	int32 PendingCount = 0;
+	for (const FTireflyActorPoolWarmUpJob& Job : WarmUpQueue)
+	{
+		const bool bSamePool = (ActorId != NAME_None) ? Job.ActorId == ActorId : (Job.ActorId == NAME_None && Job.ActorClass.Get() == ActorClass);
+		if (bSamePool)
+		{
+			PendingCount += Job.TotalCount - Job.ProcessedCount;
+		}
 	}
 
-	return Actor;
+	return PendingCount;
 }
 
-void UTireflyActorPoolWorldSubsystem::RecycleActorToPool(AActor* Actor)
+void UTireflyActorPoolWorldSubsystem::StashPersistentActorPools()
 {
-	if (!IsValid(Actor))
+	// 过渡地图没有取回持久对象池，游戏实例中保存的记录原样留给目标地图
+	const UWorld* World = GetWorld();
+	if (IsValid(World) && IsTransitionWorld(*World))
 	{
-		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Invalid Actor"), *FString(__FUNCTION__));
 		return;
 	}
 
-	FScopeLock Lock(&PoolLock);
-	
-	FName ActorId = NAME_None;
-	if (Actor->Implements<UTireflyPoolingActorInterface>())
+	UGameInstance* GameInstance = IsValid(World) && World->IsGameWorld() ? World->GetGameInstance() : nullptr;
+	UTireflyActorPoolGameInstanceSubsystem* PersistentSubsystem = GameInstance ? GameInstance->GetSubsystem<UTireflyActorPoolGameInstanceSubsystem>() : nullptr;
+	if (!PersistentSubsystem)
 	{
-		ActorId = ITireflyPoolingActorInterface::Execute_PoolingGetActorId(Actor);
-		ITireflyPoolingActorInterface::Execute_PoolingEndPlay(Actor);
+		return;
 	}
 
-	if (ActorId != NAME_None)
+	TArray<FTireflyPersistentActorPool> PersistentPools;
+	auto AppendPool = [this, &PersistentPools](const FTireflyActorPool& Pool, FName ActorId)
 	{
-		FTireflyActorPool& Pool = ActorPoolOfId.FindOrAdd(ActorId);
-		Pool.ActorPool.Push(Actor);
+		if (!Pool.Policy.bPersistAcrossTravel || !Pool.ActorClass)
+		{
+			return;
+		}
 
-		return;
-	}
+		// 按对象池达到过的规模重新预热，不超过容量上限；世界存在时间很短、恢复的预热尚未完成时，
+		// 仍然按恢复时的数量以及还在队列中的部分保存，不会随着每次切换地图逐渐缩小
+		int32 WarmUpCount = FMath::Max3(Pool.ActorPool.Num() + GetPendingWarmUpActorCountOfPool(Pool.ActorClass, ActorId), Pool.PeakActiveCount, Pool.PersistentWarmUpCount);
+		if (Pool.Policy.MaxIdleCount > 0)
+		{
+			WarmUpCount = FMath::Min(WarmUpCount, Pool.Policy.MaxIdleCount);
+		}
 
-	FTireflyActorPool& Pool = ActorPoolOfClass.FindOrAdd(Actor->GetClass());	
-	Pool.ActorPool.Push(Actor);	
-}
+		FTireflyPersistentActorPool& PersistentPool = PersistentPools.AddDefaulted_GetRef();
+		PersistentPool.ActorClass = Pool.ActorClass;
+		PersistentPool.ActorId = ActorId;
+		PersistentPool.Policy = Pool.Policy;
+		PersistentPool.WarmUpCount = WarmUpCount;
+	};
 
-void UTireflyActorPoolWorldSubsystem::WarmUpActorPool(
-	TSubclassOf<AActor> ActorClass,
-	FName ActorId,
-	int32 Count)
-{
-	if (!IsValid(ActorClass))
+	for (const auto& PoolEntry : ActorPoolIndexOfClass)
 	{
-		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Invalid ActorClass"), *FString(__FUNCTION__));
-		return;
+		AppendPool(ActorPools[PoolEntry.Value], NAME_None);
 	}
 
-	if (!ActorClass->ImplementsInterface(UTireflyPoolingActorInterface::StaticClass()))
+	for (const auto& PoolEntry : ActorPoolIndexOfId)
 	{
-		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] ActorClass %s does not implement UTireflyPoolingActorInterface"),
-			*FString(__FUNCTION__),
-			*ActorClass->GetName());
-		return;
+		AppendPool(ActorPools[PoolEntry.Value], PoolEntry.Key);
 	}
 
-	if (Count <= 0)
+	PersistentSubsystem->StashPersistentActorPools(PersistentPools);
+}
+
+void UTireflyActorPoolWorldSubsystem::RestorePersistentActorPools()
+{
+	// 过渡地图只存在很短的时间，在这里预热的Actor很快会随过渡地图一起销毁
+	const UWorld* World = GetWorld();
+	if (IsValid(World) && IsTransitionWorld(*World))
 	{
-		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Count must be greater than 0"), *FString(__FUNCTION__));
 		return;
 	}
-	
-	UWorld* World = GetWorld();
-	if (!IsValid(World))
+
+	UGameInstance* GameInstance = IsValid(World) ? World->GetGameInstance() : nullptr;
+	UTireflyActorPoolGameInstanceSubsystem* PersistentSubsystem = GameInstance ? GameInstance->GetSubsystem<UTireflyActorPoolGameInstanceSubsystem>() : nullptr;
+	if (!PersistentSubsystem)
 	{
-		UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Invalid World"), *FString(__FUNCTION__));
 		return;
 	}
 
-	FScopeLock Lock(&PoolLock);
-
-	FActorSpawnParameters SpawnParameters;
-	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-	FTireflyActorPool& Pool = ActorId != NAME_None ? ActorPoolOfId.FindOrAdd(ActorId) : ActorPoolOfClass.FindOrAdd(ActorClass);
-	Pool.ActorPool.Reserve(Pool.ActorPool.Num() + Count);
-	
-	for (int32 i = 0; i < Count; i++)
+	const int32 Priority = GetDefault<UTireflyActorPoolSettings>()->PersistentPoolWarmUpPriority;
+	for (const FTireflyPersistentActorPool& PersistentPool : PersistentSubsystem->TakePersistentActorPools())
 	{
-		AActor* Actor = World->SpawnActor<AActor>(ActorClass, FTransform::Identity, SpawnParameters);
-		if (!IsValid(Actor))
+		if (!IsValid(PersistentPool.ActorClass))
 		{
-			UE_LOG(LogTireflyActorPool, Error, TEXT("[%s] Failed to spawn ActorClass %s"),
-				*FString(__FUNCTION__),
-				*ActorClass->GetName());
 			continue;
 		}
-		
-		if (ActorId != NAME_None)
+
+		FTireflyActorPool& Pool = FindOrAddActorPool(PersistentPool.ActorClass, PersistentPool.ActorId);
+		Pool.Policy = PersistentPool.Policy;
+		Pool.PersistentWarmUpCount = PersistentPool.WarmUpCount;
+		if (PersistentPool.WarmUpCount > 0)
+		{
+			QueueWarmUpActorPool(PersistentPool.ActorClass, PersistentPool.ActorId, PersistentPool.WarmUpCount, Priority);
+		}
+	}
+}
+
+bool UTireflyActorPoolWorldSubsystem::IsTransitionWorld(const UWorld& InWorld)
+{
+	const FString TransitionMap = UGameMapsSettings::GetGameMapsSettings()->TransitionMap.GetLongPackageName();
+	return !TransitionMap.IsEmpty() && TransitionMap == GetMapPackageName(InWorld);
+}
+
+FString UTireflyActorPoolWorldSubsystem::GetMapPackageName(const UWorld& InWorld)
+{
+	// PIE中的地图包名带有前缀，需要去掉后再与配置比较
+	return UWorld::RemovePIEPrefix(InWorld.GetOutermost()->GetName());
+}
+
+FTireflyPooledActorRecord& UTireflyActorPoolWorldSubsystem::AddPooledActorRecord(AActor* Actor, int32 PoolIndex)
+{
+	FTireflyPooledActorRecord& Record = PooledActorRecords.FindOrAdd(Actor);
+	Record.HomePool = MakeActorPoolKey(PoolIndex);
+
+	Actor->OnDestroyed.AddUniqueDynamic(this, &UTireflyActorPoolWorldSubsystem::HandlePooledActorDestroyed);
+
+	return Record;
+}
+
+TSharedPtr<FTireflyPooledActorComponents, ESPMode::NotThreadSafe>* UTireflyActorPoolWorldSubsystem::FindPooledActorComponents(const AActor* Actor)
+{
+	FTireflyPooledActorRecord* Record = PooledActorRecords.Find(Actor);
+	return Record ? &Record->Components : nullptr;
+}
+
+void UTireflyActorPoolWorldSubsystem::HandlePooledActorDestroyed(AActor* DestroyedActor)
+{
+	if (FTireflyPooledActorRecord* Record = PooledActorRecords.Find(DestroyedActor))
+	{
+		// 待命的Actor只会在它的所属对象池中，同时移除它的待命时间和冷待命计数
+		const int32 HomePoolIndex = ResolveActorPoolIndex(Record->HomePool);
+		if (HomePoolIndex != INDEX_NONE)
 		{
-			ITireflyPoolingActorInterface::Execute_PoolingSetActorId(Actor, ActorId);
+			ActorPools[HomePoolIndex].RemoveIdleActor(DestroyedActor);
 		}
-		ITireflyPoolingActorInterface::Execute_PoolingWarmUp(Actor);
 
-		Pool.ActorPool.Push(Actor);
+		RemoveActiveActor(DestroyedActor, *Record);
+		PooledActorRecords.Remove(DestroyedActor);
 	}
 }
 
 TArray<TSubclassOf<AActor>> UTireflyActorPoolWorldSubsystem::Debug_GetAllActorPoolClasses() const
 {
 	TArray<TSubclassOf<AActor>> ActorClasses;
-	ActorPoolOfClass.GetKeys(ActorClasses);
+	ActorPoolIndexOfClass.GetKeys(ActorClasses);
 
 	return ActorClasses;
 }
@@ -285,27 +3312,182 @@ TArray<TSubclassOf<AActor>> UTireflyActorPoolWorldSubsystem::Debug_GetAllActorPo
 TArray<FName> UTireflyActorPoolWorldSubsystem::Debug_GetAllActorPoolIds() const
 {
 	TArray<FName> ActorIds;
-	ActorPoolOfId.GetKeys(ActorIds);
+	ActorPoolIndexOfId.GetKeys(ActorIds);
 
 	return ActorIds;
 }
 
 int32 UTireflyActorPoolWorldSubsystem::Debug_GetActorNumberOfClassPool(const TSubclassOf<AActor>& ActorClass) const
 {
-	if (!ActorPoolOfClass.Contains(ActorClass))
+	const FTireflyActorPool* Pool = FindActorPool(ActorClass, NAME_None);
+	if (!Pool)
 	{
 		return -1;
 	}
 
-	return ActorPoolOfClass[ActorClass].ActorPool.Num();
+	return Pool->ActorPool.Num();
 }
 
 int32 UTireflyActorPoolWorldSubsystem::Debug_GetActorNumberOfIdPool(FName ActorId) const
 {
-	if (!ActorPoolOfId.Contains(ActorId))
+	const FTireflyActorPool* Pool = ActorId != NAME_None ? FindActorPool(nullptr, ActorId) : nullptr;
+	if (!Pool)
+	{
+		return -1;
+	}
+
+	return Pool->ActorPool.Num();
+}
+
+FTireflyActorPoolStats UTireflyActorPoolWorldSubsystem::Debug_GetActorPoolStatsOfClass(TSubclassOf<AActor> ActorClass) const
+{
+	const FTireflyActorPool* Pool = FindActorPool(ActorClass, NAME_None);
+	return Pool ? MakeActorPoolStats(*Pool) : FTireflyActorPoolStats();
+}
+
+FTireflyActorPoolStats UTireflyActorPoolWorldSubsystem::Debug_GetActorPoolStatsOfId(FName ActorId) const
+{
+	const FTireflyActorPool* Pool = ActorId != NAME_None ? FindActorPool(nullptr, ActorId) : nullptr;
+	return Pool ? MakeActorPoolStats(*Pool) : FTireflyActorPoolStats();
+}
+
+TArray<TSubclassOf<UObject>> UTireflyActorPoolWorldSubsystem::Debug_GetAllObjectPoolClasses() const
+{
+	TArray<TSubclassOf<UObject>> ObjectClasses;
+	ObjectPoolOfClass.GetKeys(ObjectClasses);
+
+	return ObjectClasses;
+}
+
+int32 UTireflyActorPoolWorldSubsystem::Debug_GetObjectNumberOfClassPool(TSubclassOf<UObject> ObjectClass) const
+{
+	const FTireflyObjectPool* Pool = ObjectPoolOfClass.Find(ObjectClass);
+	if (!Pool)
 	{
 		return -1;
 	}
 
-	return ActorPoolOfId[ActorId].ActorPool.Num();
+	return Pool->ObjectPool.Num();
+}
+
+FTireflyActorPoolStats UTireflyActorPoolWorldSubsystem::Debug_GetObjectPoolStatsOfClass(TSubclassOf<UObject> ObjectClass) const
+{
+	const FTireflyObjectPool* Pool = ObjectPoolOfClass.Find(ObjectClass);
+	return Pool ? MakeActorPoolStats(*Pool) : FTireflyActorPoolStats();
+}
+
+void UTireflyActorPoolWorldSubsystem::DumpActorPoolStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("%-48s %6s %8s %6s %6s %6s %8s %8s %7s %8s %8s"),
+		TEXT("Pool"), TEXT("Idle"), TEXT("ColdIdle"), TEXT("Active"), TEXT("Proxy"), TEXT("Peak"), TEXT("Hits"), TEXT("Misses"), TEXT("HitRate"), TEXT("Cold"), TEXT("Recycle"));
+
+	auto DumpPool = [&Ar](const FString& PoolName, const FTireflyActorPoolStats& Stats)
+	{
+		Ar.Logf(TEXT("%-48s %6d %8d %6d %6d %6d %8d %8d %6.1f%% %8d %8d"),
+			*PoolName,
+			Stats.IdleCount,
+			Stats.ColdIdleCount,
+			Stats.ActiveCount,
+			Stats.ProxyCount,
+			Stats.PeakActiveCount,
+			Stats.HitCount,
+			Stats.MissCount,
+			Stats.HitRate * 100.f,
+			Stats.ColdSpawnCount,
+			Stats.RecycleCount);
+	};
+
+	for (const auto& PoolEntry : ActorPoolIndexOfClass)
+	{
+		DumpPool(GetNameSafe(PoolEntry.Key), MakeActorPoolStats(ActorPools[PoolEntry.Value]));
+	}
+
+	for (const auto& PoolEntry : ActorPoolIndexOfId)
+	{
+		DumpPool(FString::Printf(TEXT("Id:%s"), *PoolEntry.Key.ToString()), MakeActorPoolStats(ActorPools[PoolEntry.Value]));
+	}
+
+	for (const auto& PoolEntry : ObjectPoolOfClass)
+	{
+		DumpPool(FString::Printf(TEXT("Obj:%s"), *GetNameSafe(PoolEntry.Key)), MakeActorPoolStats(PoolEntry.Value));
+	}
+}
+
+void UTireflyActorPoolWorldSubsystem::ResetActorPoolStats()
+{
+	auto ResetPool = [](auto& Pool)
+	{
+		Pool.HitCount = 0;
+		Pool.MissCount = 0;
+		Pool.ColdSpawnCount = 0;
+		Pool.RecycleCount = 0;
+	};
+
+	// 被清理的对象池已经重置为空，一并处理不影响结果
+	for (FTireflyActorPool& Pool : ActorPools)
+	{
+		ResetPool(Pool);
+		Pool.PeakActiveCount = Pool.ActiveActors.Num();
+	}
+
+	for (auto& PoolEntry : ObjectPoolOfClass)
+	{
+		ResetPool(PoolEntry.Value);
+		PoolEntry.Value.PeakActiveCount = PoolEntry.Value.ActiveCount;
+	}
+}
+
+FTireflyActorPoolStats UTireflyActorPoolWorldSubsystem::MakeActorPoolStats(const FTireflyActorPool& Pool)
+{
+	FTireflyActorPoolStats Stats;
+	Stats.IdleCount = Pool.ActorPool.Num();
+	Stats.ColdIdleCount = Pool.NumColdIdle;
+	Stats.ProxyCount = Pool.Proxies.Num();
+	Stats.ActiveCount = Pool.ActiveActors.Num();
+	Stats.PeakActiveCount = Pool.PeakActiveCount;
+	Stats.HitCount = Pool.HitCount;
+	Stats.MissCount = Pool.MissCount;
+	Stats.ColdSpawnCount = Pool.ColdSpawnCount;
+	Stats.RecycleCount = Pool.RecycleCount;
+
+	const int32 DemandCount = Pool.HitCount + Pool.MissCount;
+	Stats.HitRate = DemandCount > 0 ? static_cast<float>(Pool.HitCount) / DemandCount : 0.f;
+
+	return Stats;
+}
+
+FTireflyActorPoolStats UTireflyActorPoolWorldSubsystem::MakeActorPoolStats(const FTireflyObjectPool& Pool)
+{
+	FTireflyActorPoolStats Stats;
+	Stats.IdleCount = Pool.ObjectPool.Num();
+	Stats.ActiveCount = Pool.ActiveCount;
+	Stats.PeakActiveCount = Pool.PeakActiveCount;
+	Stats.HitCount = Pool.HitCount;
+	Stats.MissCount = Pool.MissCount;
+	Stats.ColdSpawnCount = Pool.ColdSpawnCount;
+	Stats.RecycleCount = Pool.RecycleCount;
+
+	const int32 DemandCount = Pool.HitCount + Pool.MissCount;
+	Stats.HitRate = DemandCount > 0 ? static_cast<float>(Pool.HitCount) / DemandCount : 0.f;
+
+	return Stats;
+}
+
+void UTireflyActorPoolWorldSubsystem::TickActorPoolStats()
+{
+	int32 IdleCount = 0;
+	int32 ActiveCount = 0;
+	for (const FTireflyActorPool& Pool : ActorPools)
+	{
+		IdleCount += Pool.ActorPool.Num();
+		ActiveCount += Pool.ActiveActors.Num();
+	}
+
+	// 多个世界（例如PIE多客户端）的统计会累加在一起
+	INC_DWORD_STAT_BY(STAT_TireflyActorPool_IdleActors, IdleCount);
+	INC_DWORD_STAT_BY(STAT_TireflyActorPool_ActiveActors, ActiveCount);
+	CSV_CUSTOM_STAT(TireflyActorPool, IdleActors, IdleCount, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(TireflyActorPool, ActiveActors, ActiveCount, ECsvCustomStatOp::Accumulate);
+	TRACE_COUNTER_SET(TireflyActorPool_IdleActors, IdleCount);
+	TRACE_COUNTER_SET(TireflyActorPool_ActiveActors, ActiveCount);
 }
@@ -0,0 +1,188 @@
+// Copyright Tirefly. All Rights Reserved.
+
+
+#include "TireflyActorStateSnapshot.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "TireflyPoolingActorDispatch.h"
+#include "TireflyPoolingActorInterface.h"
+#include "TireflyPoolingObjectDispatch.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UnrealType.h"
+
+
+namespace TireflyActorPool
+{
+	// 各个Actor类型的重置属性列表，只在游戏线程上访问
+	static TMap<TObjectKey<UClass>, TSharedRef<const FTireflyActorResetLayout>> ResetLayouts;
+
+	// 清理缓存的委托句柄
+	static FDelegateHandle ReloadCompleteHandle;
+	static FDelegateHandle ObjectsReinstancedHandle;
+	static FDelegateHandle PostWorldCleanupHandle;
+
+	// 清空所有按类型缓存的数据：重置属性列表以及接口的调用记录
+	static void ResetClassCaches()
+	{
+		ResetLayouts.Empty();
+		FTireflyPoolingActorDispatch::ResetCache();
+		FTireflyPoolingObjectDispatch::ResetCache();
+	}
+
+	static bool ShouldResetProperty(const FProperty* Property)
+	{
+		if (Property->HasAnyPropertyFlags(CPF_Deprecated | CPF_EditorOnly) || Property->ArrayDim != 1)
+		{
+			return false;
+		}
+
+		// 蓝图的事件图表帧，重置会破坏蓝图虚拟机的状态
+		if (Property->GetFName() == TEXT("UberGraphFrame"))
+		{
+			return false;
+		}
+
+		return !Property->IsA<FDelegateProperty>() && !Property->IsA<FMulticastDelegateProperty>();
+	}
+}
+
+
+TSharedRef<const FTireflyActorResetLayout> FTireflyActorResetLayout::Get(const UClass* ActorClass)
+{
+	if (const TSharedRef<const FTireflyActorResetLayout>* CachedLayout = TireflyActorPool::ResetLayouts.Find(ActorClass))
+	{
+		return *CachedLayout;
+	}
+
+	TSharedRef<FTireflyActorResetLayout> Layout = MakeShared<FTireflyActorResetLayout>();
+	for (TFieldIterator<FProperty> It(ActorClass); It; ++It)
+	{
+		const FProperty* Property = *It;
+		const UClass* OwnerClass = Property->GetOwnerClass();
+		if (!OwnerClass || !OwnerClass->ImplementsInterface(UTireflyPoolingActorInterface::StaticClass()))
+		{
+			continue;
+		}
+
+		if (!TireflyActorPool::ShouldResetProperty(Property))
+		{
+			continue;
+		}
+
+		if (const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
+		{
+			Layout->ObjectProperties.Add(ObjectProperty);
+			continue;
+		}
+
+		TArray<const FStructProperty*> EncounteredStructProperties;
+		if (Property->ContainsObjectReference(EncounteredStructProperties, EPropertyObjectReferenceType::Strong))
+		{
+			continue;
+		}
+
+		const int32 Alignment = Property->GetMinAlignment();
+		Layout->BufferSize = Align(Layout->BufferSize, Alignment);
+		Layout->BufferAlignment = FMath::Max(Layout->BufferAlignment, Alignment);
+		Layout->ValueProperties.Add(Property);
+		Layout->ValueOffsets.Add(Layout->BufferSize);
+		Layout->BufferSize += Property->GetSize();
+	}
+
+	TireflyActorPool::ResetLayouts.Add(ActorClass, Layout);
+	return Layout;
+}
+
+void FTireflyActorResetLayout::RegisterCacheInvalidation()
+{
+	// 已有的快照仍然持有旧的属性列表，只有之后新生成的Actor使用重新构建的列表
+	TireflyActorPool::ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason)
+	{
+		TireflyActorPool::ResetClassCaches();
+	});
+
+	TireflyActorPool::ObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda([](const TMap<UObject*, UObject*>&)
+	{
+		TireflyActorPool::ResetClassCaches();
+	});
+
+	TireflyActorPool::PostWorldCleanupHandle = FWorldDelegates::OnPostWorldCleanup.AddLambda([](UWorld* World, bool, bool)
+	{
+		if (World && World->IsGameWorld())
+		{
+			TireflyActorPool::ResetClassCaches();
+		}
+	});
+}
+
+void FTireflyActorResetLayout::UnregisterCacheInvalidation()
+{
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(TireflyActorPool::ReloadCompleteHandle);
+	FCoreUObjectDelegates::OnObjectsReinstanced.Remove(TireflyActorPool::ObjectsReinstancedHandle);
+	FWorldDelegates::OnPostWorldCleanup.Remove(TireflyActorPool::PostWorldCleanupHandle);
+	TireflyActorPool::ResetClassCaches();
+}
+
+FTireflyActorStateSnapshot::FTireflyActorStateSnapshot(const AActor* Actor)
+	: Layout(FTireflyActorResetLayout::Get(Actor->GetClass()))
+{
+	if (Layout->BufferSize > 0)
+	{
+		Buffer = static_cast<uint8*>(FMemory::Malloc(Layout->BufferSize, Layout->BufferAlignment));
+		for (int32 Index = 0; Index < Layout->ValueProperties.Num(); ++Index)
+		{
+			const FProperty* Property = Layout->ValueProperties[Index];
+			uint8* Value = Buffer + Layout->ValueOffsets[Index];
+			Property->InitializeValue(Value);
+			Property->CopyCompleteValue(Value, Property->ContainerPtrToValuePtr<void>(Actor));
+		}
+	}
+
+	ObjectValues.Reserve(Layout->ObjectProperties.Num());
+	for (const FObjectPropertyBase* Property : Layout->ObjectProperties)
+	{
+		ObjectValues.Add(Property->GetObjectPropertyValue_InContainer(Actor));
+	}
+}
+
+FTireflyActorStateSnapshot::~FTireflyActorStateSnapshot()
+{
+	if (Buffer)
+	{
+		for (int32 Index = 0; Index < Layout->ValueProperties.Num(); ++Index)
+		{
+			Layout->ValueProperties[Index]->DestroyValue(Buffer + Layout->ValueOffsets[Index]);
+		}
+		FMemory::Free(Buffer);
+	}
+}
+
+int32 FTireflyActorStateSnapshot::Restore(AActor* Actor) const
+{
+	int32 RestoredNum = 0;
+	for (int32 Index = 0; Index < Layout->ValueProperties.Num(); ++Index)
+	{
+		const FProperty* Property = Layout->ValueProperties[Index];
+		const uint8* SnapshotValue = Buffer + Layout->ValueOffsets[Index];
+		void* ActorValue = Property->ContainerPtrToValuePtr<void>(Actor);
+		if (!Property->Identical(ActorValue, SnapshotValue))
+		{
+			Property->CopyCompleteValue(ActorValue, SnapshotValue);
+			++RestoredNum;
+		}
+	}
+
+	for (int32 Index = 0; Index < Layout->ObjectProperties.Num(); ++Index)
+	{
+		const FObjectPropertyBase* Property = Layout->ObjectProperties[Index];
+		UObject* SnapshotObject = ObjectValues[Index].Get();
+		if (Property->GetObjectPropertyValue_InContainer(Actor) != SnapshotObject)
+		{
+			Property->SetObjectPropertyValue_InContainer(Actor, SnapshotObject);
+			++RestoredNum;
+		}
+	}
+
+	return RestoredNum;
+}
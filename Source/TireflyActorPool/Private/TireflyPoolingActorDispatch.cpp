@@ -0,0 +1,146 @@
+// Copyright Tirefly. All Rights Reserved.
+
+
+#include "TireflyPoolingActorDispatch.h"
+
+#include "GameFramework/Actor.h"
+#include "TireflyPoolingActorInterface.h"
+
+
+namespace TireflyActorPool
+{
+	// 与UHT为BlueprintNativeEvent生成的参数结构体布局一致
+	struct FPoolingInitializedParams
+	{
+		FInstancedStruct InitialData;
+	};
+
+	struct FPoolingGetActorIdParams
+	{
+		FName ReturnValue;
+	};
+
+	struct FPoolingSetActorIdParams
+	{
+		FName NewActorId;
+	};
+}
+
+
+FTireflyPoolingActorDispatch::FCache FTireflyPoolingActorDispatch::Cache;
+
+
+bool FTireflyPoolingActorDispatch::Implements(const UClass* ActorClass)
+{
+	return ActorClass && GetRecord(ActorClass).bImplementsInterface;
+}
+
+void FTireflyPoolingActorDispatch::PoolingBeginPlay(AActor* Actor)
+{
+	const FRecord& Record = GetRecord(Actor->GetClass());
+	if (UFunction* Function = GetScriptFunction(Record, EEvent::BeginPlay))
+	{
+		Actor->ProcessEvent(Function, nullptr);
+	}
+	else if (ITireflyPoolingActorInterface* Interface = GetNativeInterface(Actor, Record))
+	{
+		Interface->PoolingBeginPlay_Implementation();
+	}
+}
+
+void FTireflyPoolingActorDispatch::PoolingInitialized(AActor* Actor, const FInstancedStruct& InitialData)
+{
+	const FRecord& Record = GetRecord(Actor->GetClass());
+	if (UFunction* Function = GetScriptFunction(Record, EEvent::Initialized))
+	{
+		TireflyActorPool::FPoolingInitializedParams Params{ InitialData };
+		Actor->ProcessEvent(Function, &Params);
+	}
+	else if (ITireflyPoolingActorInterface* Interface = GetNativeInterface(Actor, Record))
+	{
+		Interface->PoolingInitialized_Implementation(InitialData);
+	}
+}
+
+void FTireflyPoolingActorDispatch::PoolingEndPlay(AActor* Actor)
+{
+	const FRecord& Record = GetRecord(Actor->GetClass());
+	if (UFunction* Function = GetScriptFunction(Record, EEvent::EndPlay))
+	{
+		Actor->ProcessEvent(Function, nullptr);
+	}
+	else if (ITireflyPoolingActorInterface* Interface = GetNativeInterface(Actor, Record))
+	{
+		Interface->PoolingEndPlay_Implementation();
+	}
+}
+
+void FTireflyPoolingActorDispatch::PoolingWarmUp(AActor* Actor)
+{
+	const FRecord& Record = GetRecord(Actor->GetClass());
+	if (UFunction* Function = GetScriptFunction(Record, EEvent::WarmUp))
+	{
+		Actor->ProcessEvent(Function, nullptr);
+	}
+	else if (ITireflyPoolingActorInterface* Interface = GetNativeInterface(Actor, Record))
+	{
+		Interface->PoolingWarmUp_Implementation();
+	}
+}
+
+FName FTireflyPoolingActorDispatch::PoolingGetActorId(AActor* Actor)
+{
+	const FRecord& Record = GetRecord(Actor->GetClass());
+	if (UFunction* Function = GetScriptFunction(Record, EEvent::GetActorId))
+	{
+		TireflyActorPool::FPoolingGetActorIdParams Params;
+		Actor->ProcessEvent(Function, &Params);
+		return Params.ReturnValue;
+	}
+
+	if (const ITireflyPoolingActorInterface* Interface = GetNativeInterface(Actor, Record))
+	{
+		return Interface->PoolingGetActorId_Implementation();
+	}
+
+	return NAME_None;
+}
+
+void FTireflyPoolingActorDispatch::PoolingSetActorId(AActor* Actor, FName NewActorId)
+{
+	const FRecord& Record = GetRecord(Actor->GetClass());
+	if (UFunction* Function = GetScriptFunction(Record, EEvent::SetActorId))
+	{
+		TireflyActorPool::FPoolingSetActorIdParams Params{ NewActorId };
+		Actor->ProcessEvent(Function, &Params);
+	}
+	else if (ITireflyPoolingActorInterface* Interface = GetNativeInterface(Actor, Record))
+	{
+		Interface->PoolingSetActorId_Implementation(NewActorId);
+	}
+}
+
+void FTireflyPoolingActorDispatch::ResetCache()
+{
+	Cache.Reset();
+}
+
+const FTireflyPoolingActorDispatch::FRecord& FTireflyPoolingActorDispatch::GetRecord(const UClass* ActorClass)
+{
+	static const FName EventNames[] = {
+		GET_FUNCTION_NAME_CHECKED(ITireflyPoolingActorInterface, PoolingBeginPlay),
+		GET_FUNCTION_NAME_CHECKED(ITireflyPoolingActorInterface, PoolingInitialized),
+		GET_FUNCTION_NAME_CHECKED(ITireflyPoolingActorInterface, PoolingEndPlay),
+		GET_FUNCTION_NAME_CHECKED(ITireflyPoolingActorInterface, PoolingWarmUp),
+		GET_FUNCTION_NAME_CHECKED(ITireflyPoolingActorInterface, PoolingGetActorId),
+		GET_FUNCTION_NAME_CHECKED(ITireflyPoolingActorInterface, PoolingSetActorId),
+	};
+	static_assert(UE_ARRAY_COUNT(EventNames) == static_cast<int32>(EEvent::Num));
+
+	return Cache.Get(ActorClass, EventNames);
+}
+
+ITireflyPoolingActorInterface* FTireflyPoolingActorDispatch::GetNativeInterface(AActor* Actor, const FRecord& Record)
+{
+	return Record.GetNativeInterface(Actor);
+}
@@ -0,0 +1,23 @@
+// Copyright Tirefly. All Rights Reserved.
+
+
+#include "TireflyPoolingActorTypedInit.h"
+
+#include "TireflyActorPoolLogChannels.h"
+#include "TireflyPoolingActorDispatch.h"
+
+
+
+void FTireflyPoolingInitialDataRef::Apply(AActor* Actor) const
+{
+	if (InstancedStruct)
+	{
+		FTireflyPoolingActorDispatch::PoolingInitialized(Actor, *InstancedStruct);
+	}
+	else if (TypedData && !ApplyTyped(Actor, TypedData))
+	{
+		UE_LOG(LogTireflyActorPool, Warning, TEXT("[%s] Actor %s does not accept the typed initial data"),
+			*FString(__FUNCTION__),
+			*Actor->GetName());
+	}
+}
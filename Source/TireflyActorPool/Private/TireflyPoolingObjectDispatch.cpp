@@ -0,0 +1,101 @@
+// Copyright Tirefly. All Rights Reserved.
+
+
+#include "TireflyPoolingObjectDispatch.h"
+
+#include "TireflyPoolingObjectInterface.h"
+
+
+namespace TireflyActorPool
+{
+	// 与UHT为BlueprintNativeEvent生成的参数结构体布局一致
+	struct FPoolingObjectInitializedParams
+	{
+		FInstancedStruct InitialData;
+	};
+}
+
+
+FTireflyPoolingObjectDispatch::FCache FTireflyPoolingObjectDispatch::Cache;
+
+
+bool FTireflyPoolingObjectDispatch::Implements(const UClass* ObjectClass)
+{
+	return ObjectClass && GetRecord(ObjectClass).bImplementsInterface;
+}
+
+void FTireflyPoolingObjectDispatch::PoolingBeginPlay(UObject* Object)
+{
+	const FRecord& Record = GetRecord(Object->GetClass());
+	if (UFunction* Function = GetScriptFunction(Record, EEvent::BeginPlay))
+	{
+		Object->ProcessEvent(Function, nullptr);
+	}
+	else if (ITireflyPoolingObjectInterface* Interface = GetNativeInterface(Object, Record))
+	{
+		Interface->PoolingBeginPlay_Implementation();
+	}
+}
+
+void FTireflyPoolingObjectDispatch::PoolingInitialized(UObject* Object, const FInstancedStruct& InitialData)
+{
+	const FRecord& Record = GetRecord(Object->GetClass());
+	if (UFunction* Function = GetScriptFunction(Record, EEvent::Initialized))
+	{
+		TireflyActorPool::FPoolingObjectInitializedParams Params{ InitialData };
+		Object->ProcessEvent(Function, &Params);
+	}
+	else if (ITireflyPoolingObjectInterface* Interface = GetNativeInterface(Object, Record))
+	{
+		Interface->PoolingInitialized_Implementation(InitialData);
+	}
+}
+
+void FTireflyPoolingObjectDispatch::PoolingEndPlay(UObject* Object)
+{
+	const FRecord& Record = GetRecord(Object->GetClass());
+	if (UFunction* Function = GetScriptFunction(Record, EEvent::EndPlay))
+	{
+		Object->ProcessEvent(Function, nullptr);
+	}
+	else if (ITireflyPoolingObjectInterface* Interface = GetNativeInterface(Object, Record))
+	{
+		Interface->PoolingEndPlay_Implementation();
+	}
+}
+
+void FTireflyPoolingObjectDispatch::PoolingWarmUp(UObject* Object)
+{
+	const FRecord& Record = GetRecord(Object->GetClass());
+	if (UFunction* Function = GetScriptFunction(Record, EEvent::WarmUp))
+	{
+		Object->ProcessEvent(Function, nullptr);
+	}
+	else if (ITireflyPoolingObjectInterface* Interface = GetNativeInterface(Object, Record))
+	{
+		Interface->PoolingWarmUp_Implementation();
+	}
+}
+
+void FTireflyPoolingObjectDispatch::ResetCache()
+{
+	Cache.Reset();
+}
+
+const FTireflyPoolingObjectDispatch::FRecord& FTireflyPoolingObjectDispatch::GetRecord(const UClass* ObjectClass)
+{
+	static const FName EventNames[] = {
+		GET_FUNCTION_NAME_CHECKED(ITireflyPoolingObjectInterface, PoolingBeginPlay),
+		GET_FUNCTION_NAME_CHECKED(ITireflyPoolingObjectInterface, PoolingInitialized),
+		GET_FUNCTION_NAME_CHECKED(ITireflyPoolingObjectInterface, PoolingEndPlay),
+		GET_FUNCTION_NAME_CHECKED(ITireflyPoolingObjectInterface, PoolingWarmUp),
+	};
+	static_assert(UE_ARRAY_COUNT(EventNames) == static_cast<int32>(EEvent::Num));
+
+	return Cache.Get(ObjectClass, EventNames);
+}
+
+ITireflyPoolingObjectInterface* FTireflyPoolingObjectDispatch::GetNativeInterface(UObject* Object, const FRecord& Record)
+{
+	return Record.GetNativeInterface(Object);
+}
@@ -0,0 +1,5 @@
+// Copyright Tirefly. All Rights Reserved.
+
+
+#include "TireflyPoolingObjectInterface.h"
+
@@ -0,0 +1,86 @@
+// Copyright Tirefly. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+
+
+/**
+ * 对象池Actor生命周期的哈希时间轮
+ *
+ * 由对象池子系统每帧推进一次，同一个槽位内到期的Actor会被批量取出。
+ * 取消和刷新只修改Actor的登记信息（O(1)），槽位中残留的旧条目会在该槽位下一次被处理时惰性清除。
+ */
+class TIREFLYACTORPOOL_API FTireflyActorLifetimeWheel
+{
+public:
+	explicit FTireflyActorLifetimeWheel(double InSlotDuration = 1.0 / 30.0, int32 InNumSlots = 256);
+
+	/**
+	 * 登记（或刷新）Actor的到期时间，已登记的Actor会覆盖之前的到期时间
+	 *
+	 * @param Actor 要登记的Actor
+	 * @param ExpireTime 到期的世界时间（秒）
+	 */
+	void Schedule(const AActor* Actor, double ExpireTime);
+
+	// 取消Actor的到期登记，返回Actor之前是否已登记
+	bool Cancel(const AActor* Actor);
+
+	// 获取Actor的到期时间，如果Actor未登记则返回-1
+	double GetExpireTime(const AActor* Actor) const;
+
+	// Actor是否已登记到期时间
+	bool IsScheduled(const AActor* Actor) const { return ScheduledActors.Contains(Actor); }
+
+	// 已登记的Actor数量
+	int32 Num() const { return ScheduledActors.Num(); }
+
+	/**
+	 * 把时间轮推进到指定的世界时间，所有到期的Actor会被追加到OutExpiredActors中并取消登记
+	 *
+	 * @param CurrentTime 当前的世界时间（秒）
+	 * @param OutExpiredActors 到期的Actor
+	 */
+	void Advance(double CurrentTime, TArray<AActor*>& OutExpiredActors);
+
+	// 清空时间轮
+	void Empty();
+
+private:
+	// 槽位中的条目，Serial与登记信息不一致时说明条目已被取消或刷新
+	struct FEntry
+	{
+		TObjectKey<AActor> Actor;
+		double ExpireTime = 0.0;
+		uint32 Serial = 0;
+	};
+
+	// Actor当前有效的登记信息
+	struct FSchedule
+	{
+		double ExpireTime = 0.0;
+		uint32 Serial = 0;
+	};
+
+	// 到期时间向上取整到槽位边界，保证处理槽位时条目一定已经到期
+	int64 ExpireTimeToTick(double ExpireTime) const { return FMath::CeilToInt64(ExpireTime / SlotDuration); }
+
+	int32 TickToSlot(int64 Tick) const { return static_cast<int32>(Tick % Slots.Num()); }
+
+	void ProcessSlot(TArray<FEntry>& Slot, double CurrentTime, TArray<AActor*>& OutExpiredActors);
+
+	TArray<TArray<FEntry>> Slots;
+
+	TMap<TObjectKey<AActor>, FSchedule> ScheduledActors;
+
+	// 每个槽位代表的时间跨度（秒）
+	double SlotDuration = 1.0 / 30.0;
+
+	// 最后一个已处理的时间刻度
+	int64 CurrentTick = INDEX_NONE;
+
+	uint32 NextSerial = 1;
+};
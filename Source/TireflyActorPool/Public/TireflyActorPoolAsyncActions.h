@@ -0,0 +1,201 @@
+// Copyright Tirefly. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "StructUtils/InstancedStruct.h"
+#include "TireflyActorPoolAsyncActions.generated.h"
+
+
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FTireflyAsyncSpawnActorFromPoolPin, AActor*, Actor);
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FTireflyAsyncWarmUpActorPoolPin);
+
+
+
+// 异步加载软引用的Actor类型后从对象池中生成Actor的蓝图异步节点
+UCLASS()
+class TIREFLYACTORPOOL_API UTireflyAsyncAction_SpawnActorFromPool : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * 异步加载软引用的Actor类型及其依赖资源，加载完成后从对象池中生成Actor实例
+	 *
+	 * @param WorldContext 世界上下文对象，默认为当前世界对象，只有通过世界才能生成Actor
+	 * @param ActorClass 要生成的Actor类型
+	 * @param ActorId 要生成的Actor的Id标识
+	 * @param SpawnTransform 要生成的Actor的初始化世界坐标系下的Transform
+	 * @param InitialData Actor实例的初始化数据，无效的InstancedStruct表示不初始化
+	 * @param Lifetime 生成的Actor的存活时间，默认为-1，表示一直存活
+	 * @param CollisionHandling 生成Actor时的初始碰撞处理方式，默认为AlwaysSpawn
+	 * @param Owner 要生成的Actor的Owner，默认为空
+	 * @param Instigator 要生成的Actor的Instigator，默认为空
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (WorldContext = "WorldContext", BlueprintInternalUseOnly = "true", AutoCreateRefTerm = "InitialData", DisplayName = "Spawn Actor From Pool (Async)"))
+	static UTireflyAsyncAction_SpawnActorFromPool* SpawnActorFromPoolAsync(
+		const UObject* WorldContext,
+		TSoftClassPtr<AActor> ActorClass,
+		FName ActorId,
+		const FTransform& SpawnTransform,
+		const FInstancedStruct& InitialData,
+		float Lifetime = -1.f,
+		ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn,
+		AActor* Owner = nullptr,
+		APawn* Instigator = nullptr);
+
+	virtual void Activate() override;
+
+public:
+	// Actor类型加载完成并从对象池中生成Actor后触发
+	UPROPERTY(BlueprintAssignable)
+	FTireflyAsyncSpawnActorFromPoolPin OnSpawned;
+
+	// Actor类型加载失败或生成失败时触发
+	UPROPERTY(BlueprintAssignable)
+	FTireflyAsyncSpawnActorFromPoolPin OnFailed;
+
+private:
+	TWeakObjectPtr<UWorld> World;
+
+	TSoftClassPtr<AActor> ActorClass;
+
+	FName ActorId = NAME_None;
+
+	FTransform SpawnTransform;
+
+	FInstancedStruct InitialData;
+
+	float Lifetime = -1.f;
+
+	ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	TWeakObjectPtr<AActor> Owner;
+
+	TWeakObjectPtr<APawn> Instigator;
+};
+
+
+
+// 异步加载软引用的Actor类型后预热对象池的蓝图异步节点
+UCLASS()
+class TIREFLYACTORPOOL_API UTireflyAsyncAction_WarmUpActorPool : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * 异步加载软引用的Actor类型及其依赖资源，加载完成后通过分帧预热队列预热对象池
+	 *
+	 * @param WorldContext 世界上下文对象，默认为当前世界对象，只有通过世界才能生成Actor
+	 * @param ActorClass 对象池的目标类型
+	 * @param ActorId 对象池的目标Id
+	 * @param Count 预热的Actor数量
+	 * @param Priority 预热任务的优先级，数值越大越先执行
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (WorldContext = "WorldContext", BlueprintInternalUseOnly = "true", DisplayName = "Warm Up Actor Pool (Async)"))
+	static UTireflyAsyncAction_WarmUpActorPool* WarmUpActorPoolAsync(
+		const UObject* WorldContext,
+		TSoftClassPtr<AActor> ActorClass,
+		FName ActorId,
+		int32 Count = 16,
+		int32 Priority = 0);
+
+	virtual void Activate() override;
+
+public:
+	// Actor类型加载完成且对象池预热完成后触发
+	UPROPERTY(BlueprintAssignable)
+	FTireflyAsyncWarmUpActorPoolPin OnCompleted;
+
+	// Actor类型加载失败时触发
+	UPROPERTY(BlueprintAssignable)
+	FTireflyAsyncWarmUpActorPoolPin OnFailed;
+
+private:
+	TWeakObjectPtr<UWorld> World;
+
+	TSoftClassPtr<AActor> ActorClass;
+
+	FName ActorId = NAME_None;
+
+	int32 Count = 16;
+
+	int32 Priority = 0;
+};
+
+
+
+// 受每帧即时生成预算限制、可能延迟到之后几帧完成的从对象池中生成Actor的蓝图异步节点
+UCLASS()
+class TIREFLYACTORPOOL_API UTireflyAsyncAction_SpawnActorFromPoolDeferred : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * 从对象池中生成Actor实例，对象池中没有待命Actor且本帧即时生成预算已用完时，请求会排队到之后几帧完成
+	 *
+	 * @param WorldContext 世界上下文对象，默认为当前世界对象，只有通过世界才能生成Actor
+	 * @param ActorClass 要生成的Actor类型
+	 * @param ActorId 要生成的Actor的Id标识
+	 * @param SpawnTransform 要生成的Actor的初始化世界坐标系下的Transform
+	 * @param InitialData Actor实例的初始化数据，无效的InstancedStruct表示不初始化
+	 * @param Priority 请求优先级，数值越大越先执行
+	 * @param bDroppable 是否可以在负载过高时放弃，适用于纯表现用的Actor
+	 * @param Lifetime 生成的Actor的存活时间，默认为-1，表示一直存活
+	 * @param CollisionHandling 生成Actor时的初始碰撞处理方式，默认为AlwaysSpawn
+	 * @param Owner 要生成的Actor的Owner，默认为空
+	 * @param Instigator 要生成的Actor的Instigator，默认为空
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (WorldContext = "WorldContext", BlueprintInternalUseOnly = "true", AutoCreateRefTerm = "InitialData", DisplayName = "Spawn Actor From Pool (Deferred)"))
+	static UTireflyAsyncAction_SpawnActorFromPoolDeferred* SpawnActorFromPoolDeferred(
+		const UObject* WorldContext,
+		TSubclassOf<AActor> ActorClass,
+		FName ActorId,
+		const FTransform& SpawnTransform,
+		const FInstancedStruct& InitialData,
+		int32 Priority = 0,
+		bool bDroppable = false,
+		float Lifetime = -1.f,
+		ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn,
+		AActor* Owner = nullptr,
+		APawn* Instigator = nullptr);
+
+	virtual void Activate() override;
+
+public:
+	// 从对象池中生成Actor后触发
+	UPROPERTY(BlueprintAssignable)
+	FTireflyAsyncSpawnActorFromPoolPin OnSpawned;
+
+	// 生成失败或请求被放弃时触发
+	UPROPERTY(BlueprintAssignable)
+	FTireflyAsyncSpawnActorFromPoolPin OnFailed;
+
+private:
+	TWeakObjectPtr<UWorld> World;
+
+	TSubclassOf<AActor> ActorClass;
+
+	FName ActorId = NAME_None;
+
+	FTransform SpawnTransform;
+
+	FInstancedStruct InitialData;
+
+	int32 Priority = 0;
+
+	bool bDroppable = false;
+
+	float Lifetime = -1.f;
+
+	ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	TWeakObjectPtr<AActor> Owner;
+
+	TWeakObjectPtr<APawn> Instigator;
+};
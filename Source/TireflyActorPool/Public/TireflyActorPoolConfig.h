@@ -0,0 +1,62 @@
+// Copyright Tirefly. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "TireflyActorPoolWorldSubsystem.h"
+#include "TireflyActorPoolConfig.generated.h"
+
+
+
+// 单个Actor对象池的配置
+USTRUCT(BlueprintType)
+struct FTireflyActorPoolConfigEntry
+{
+	GENERATED_BODY()
+
+public:
+	// 对象池的目标类型，会在应用配置时异步加载
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tirefly Actor Pool")
+	TSoftClassPtr<AActor> ActorClass;
+
+	// 对象池的目标Id，为None时配置的是ActorClass的对象池
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tirefly Actor Pool")
+	FName ActorId = NAME_None;
+
+	// 预热的Actor数量，为0表示不预热
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tirefly Actor Pool|WarmUp", Meta = (ClampMin = "0"))
+	int32 WarmUpCount = 0;
+
+	// 预热任务的优先级，数值越大越先执行
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tirefly Actor Pool|WarmUp")
+	int32 WarmUpPriority = 0;
+
+	// 是否使用此配置覆盖对象池的容量与裁剪策略
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tirefly Actor Pool|Policy")
+	bool bOverridePolicy = false;
+
+	// 对象池的容量与裁剪策略
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tirefly Actor Pool|Policy", Meta = (EditCondition = "bOverridePolicy"))
+	FTireflyActorPoolPolicy Policy;
+
+public:
+	// 两个配置是否针对同一个对象池
+	bool IsSamePool(const FTireflyActorPoolConfigEntry& Other) const
+	{
+		return ActorId == Other.ActorId && (ActorId != NAME_None || ActorClass == Other.ActorClass);
+	}
+};
+
+
+
+// Actor对象池配置资产，列出需要预热和调优的对象池
+UCLASS(BlueprintType)
+class TIREFLYACTORPOOL_API UTireflyActorPoolConfig : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tirefly Actor Pool", Meta = (TitleProperty = "{ActorClass} {ActorId}"))
+	TArray<FTireflyActorPoolConfigEntry> PoolEntries;
+};
@@ -0,0 +1,74 @@
+// Copyright Tirefly. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "TireflyActorPoolWorldSubsystem.h"
+#include "TireflyActorPoolGameInstanceSubsystem.generated.h"
+
+
+
+// 跨地图保留的对象池，记录新地图中重新预热对象池所需的信息
+USTRUCT()
+struct FTireflyPersistentActorPool
+{
+	GENERATED_BODY()
+
+public:
+	// 两条记录是否针对同一个对象池
+	bool IsSamePool(const FTireflyPersistentActorPool& Other) const
+	{
+		return ActorId == Other.ActorId && (ActorId != NAME_None || ActorClass == Other.ActorClass);
+	}
+
+public:
+	// 对象池的目标类型，被记录引用期间不会被卸载
+	UPROPERTY()
+	TSubclassOf<AActor> ActorClass;
+
+	// 对象池的目标Id，为None表示ActorClass的对象池
+	UPROPERTY()
+	FName ActorId = NAME_None;
+
+	// 对象池的容量与裁剪策略
+	UPROPERTY()
+	FTireflyActorPoolPolicy Policy;
+
+	// 在新地图中预热的Actor数量
+	UPROPERTY()
+	int32 WarmUpCount = 0;
+};
+
+
+
+/**
+ * 跨地图的持久对象池层，由游戏实例持有
+ *
+ * 世界销毁时，策略中开启了bPersistAcrossTravel的对象池会把Actor类型、策略和预热数量交给该子系统保存，
+ * Actor类型因此在地图切换期间保持加载；新地图开始运行时，世界子系统取回这些记录并通过分帧预热队列重新预热。
+ */
+UCLASS()
+class TIREFLYACTORPOOL_API UTireflyActorPoolGameInstanceSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// 保存即将销毁的世界中的持久对象池，同一对象池的记录以新的为准
+	void StashPersistentActorPools(TConstArrayView<FTireflyPersistentActorPool> Pools);
+
+	// 取出保存的持久对象池，取出后子系统不再持有这些记录
+	TArray<FTireflyPersistentActorPool> TakePersistentActorPools();
+
+	// 丢弃保存的持久对象池，不再需要的Actor类型可以被卸载
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	void ClearPersistentActorPools();
+
+	// 获取保存的持久对象池数量
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	int32 GetPersistentActorPoolCount() const { return PersistentActorPools.Num(); }
+
+private:
+	UPROPERTY()
+	TArray<FTireflyPersistentActorPool> PersistentActorPools;
+};
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "StructUtils/InstancedStruct.h"
+#include "TireflyActorPoolWorldSubsystem.h"
 #include "TireflyActorPoolLibrary.generated.h"
 
 
@@ -68,6 +69,33 @@ public:
 		AActor* Owner = nullptr,
 		APawn* Instigator = nullptr);
 
+	/**
+	 * 从Actor对象池中批量生成Actor实例，适用于同一帧内生成大量同类Actor的场景（如弹幕）
+	 * 
+	 * @param WorldContext 世界上下文对象，默认为当前世界对象，只有通过世界才能生成Actor
+	 * @param ActorClass 要生成的Actor类型
+	 * @param ActorId 要生成的Actor的Id标识
+	 * @param SpawnTransforms 每个Actor的初始化世界坐标系下的Transform，生成的数量等于Transform的数量
+	 * @param InitialData Actor实例的初始化数据，为空表示不初始化，只有1个元素表示所有实例共用，否则需要与SpawnTransforms一一对应
+	 * @param OutActors 从对象池中生成的Actor实例，生成失败的实例会被跳过
+	 * @param Lifetime 生成的Actor的存活时间，默认为-1，表示一直存活
+	 * @param CollisionHandling 生成Actor时的初始碰撞处理方式，默认为AlwaysSpawn
+	 * @param Owner 要生成的Actor的Owner，默认为空
+	 * @param Instigator 要生成的Actor的Instigator，默认为空
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (WorldContext = "WorldContext", DeterminesOutputType = "ActorClass", DynamicOutputParam = "OutActors", AutoCreateRefTerm = "InitialData"))
+	static void SpawnActorsFromPool(
+		const UObject* WorldContext,
+		TSubclassOf<AActor> ActorClass,
+		FName ActorId,
+		const TArray<FTransform>& SpawnTransforms,
+		const TArray<FInstancedStruct>& InitialData,
+		TArray<AActor*>& OutActors,
+		float Lifetime = -1.f,
+		ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn,
+		AActor* Owner = nullptr,
+		APawn* Instigator = nullptr);
+
 	// 回收Actor到对象池中
 	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (WorldContext = "WorldContext"))
 	static void RecycleActorToPool(const UObject* WorldContext, AActor* Actor);
@@ -87,6 +115,78 @@ public:
 		FName ActorId,
 		int32 Count = 16);
 
+	/**
+	 * 把预热任务加入分帧预热队列，每帧在预算时间内逐步生成Actor，避免在一帧内集中生成大量Actor造成卡顿
+	 *
+	 * @param WorldContext 世界上下文对象，默认为当前世界对象，只有通过世界才能生成Actor
+	 * @param ActorClass 对象池的目标类型
+	 * @param ActorId 对象池的目标Id
+	 * @param OnCompleted 任务完成时的回调
+	 * @param Count 预热的Actor数量
+	 * @param Priority 任务优先级，数值越大越先执行
+	 * @return 预热任务的句柄，无效时返回-1
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (WorldContext = "WorldContext", AutoCreateRefTerm = "OnCompleted"))
+	static int32 QueueWarmUpActorPool(
+		const UObject* WorldContext,
+		TSubclassOf<AActor> ActorClass,
+		FName ActorId,
+		const FTireflyActorPoolWarmUpCompletedDelegate& OnCompleted,
+		int32 Count = 16,
+		int32 Priority = 0);
+
+#pragma endregion
+
+
+#pragma region ActorPool_ObjectOperation
+
+public:
+	/**
+	 * 从组件对象池中取出一个组件，注册到Owner上，场景组件会挂接到AttachParent（为空时为Owner的根组件）上
+	 *
+	 * @param WorldContext 世界上下文对象，默认为当前世界对象
+	 * @param ComponentClass 要取出的组件类型
+	 * @param Owner 组件的新Owner
+	 * @param RelativeTransform 场景组件相对挂接点的Transform
+	 * @param AttachParent 场景组件要挂接的组件，必须属于Owner
+	 * @param SocketName 挂接的插槽
+	 * @param InitialData 组件的初始化数据，只对实现了ITireflyPoolingObjectInterface的组件有效
+	 * @return 从对象池中取出的组件
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (WorldContext = "WorldContext", DeterminesOutputType = "ComponentClass", AutoCreateRefTerm = "RelativeTransform, InitialData"))
+	static UActorComponent* SpawnComponentFromPool(
+		const UObject* WorldContext,
+		TSubclassOf<UActorComponent> ComponentClass,
+		AActor* Owner,
+		const FTransform& RelativeTransform,
+		const FInstancedStruct& InitialData,
+		USceneComponent* AttachParent = nullptr,
+		FName SocketName = NAME_None);
+
+	/**
+	 * 从UObject对象池中取出一个对象
+	 *
+	 * @param WorldContext 世界上下文对象，默认为当前世界对象
+	 * @param ObjectClass 要取出的对象类型，不能是Actor或组件
+	 * @param Outer 对象的Outer，为空时使用对象池子系统
+	 * @param InitialData 对象的初始化数据，只对实现了ITireflyPoolingObjectInterface的对象有效
+	 * @return 从对象池中取出的对象
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (WorldContext = "WorldContext", DeterminesOutputType = "ObjectClass", AutoCreateRefTerm = "InitialData"))
+	static UObject* SpawnObjectFromPool(
+		const UObject* WorldContext,
+		TSubclassOf<UObject> ObjectClass,
+		UObject* Outer,
+		const FInstancedStruct& InitialData);
+
+	// 回收组件或UObject到对象池中
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (WorldContext = "WorldContext"))
+	static void RecycleObjectToPool(const UObject* WorldContext, UObject* Object);
+
+	// 预热组件或UObject对象池，创建指定数量的对象并使其在池中待命
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (WorldContext = "WorldContext"))
+	static void WarmUpObjectPool(const UObject* WorldContext, TSubclassOf<UObject> ObjectClass, int32 Count = 16);
+
 #pragma endregion
 	
 
@@ -144,8 +244,8 @@ public:
 #pragma endregion
 
 private:
-	// 处理单个组件的激活/停用
-	static void ProcessComponent(UActorComponent* Component, bool bActivate);
+	// 按对象池Actor记录中缓存的组件列表处理Actor所有组件的激活/停用
+	static void ProcessComponents(AActor* Actor, bool bActivate);
 	
 	// 处理Pawn的Controller相关操作
 	static void ProcessPawnController(APawn* Pawn, bool bActivate);
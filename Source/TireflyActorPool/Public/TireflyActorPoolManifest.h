@@ -0,0 +1,65 @@
+// Copyright Tirefly. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+
+// 对象池使用情况清单中的一条记录
+struct FTireflyActorPoolManifestEntry
+{
+	// 对象池的目标类型
+	FSoftClassPath ActorClass;
+
+	// 对象池的目标Id，为None表示ActorClass的对象池
+	FName ActorId = NAME_None;
+
+	// 同时处于激活状态的Actor数量的峰值
+	int32 PeakActiveCount = 0;
+
+	// 对象池中没有可用Actor的次数
+	int32 MissCount = 0;
+
+	// 第一次向对象池请求Actor的世界时间（秒）
+	float FirstDemandTime = 0.f;
+
+	bool IsSamePool(const FTireflyActorPoolManifestEntry& Other) const
+	{
+		return ActorId == Other.ActorId && (ActorId != NAME_None || ActorClass == Other.ActorClass);
+	}
+};
+
+
+
+/**
+ * 对象池使用情况清单，在试玩时记录每个对象池的峰值与未命中次数，下次加载地图时据此预热
+ *
+ * 清单是带版本号的纯文本文件，每行一条逗号分隔的记录：
+ *   TireflyActorPoolManifest,<Version>
+ *   Map,<MapPackageName>
+ *   Pool,<ActorClassPath>,<ActorId>,<PeakActiveCount>,<MissCount>,<FirstDemandTime>
+ */
+struct TIREFLYACTORPOOL_API FTireflyActorPoolManifest
+{
+	// 清单格式的版本号
+	static constexpr int32 Version = 1;
+
+	// 清单对应的地图包名
+	FString MapPackageName;
+
+	// 各个对象池的使用情况
+	TArray<FTireflyActorPoolManifestEntry> Entries;
+
+	// 获取地图对应的清单文件路径
+	static FString GetManifestFilePath(const FString& MapPackageName);
+
+	// 从文件中读取清单，文件不存在、版本不匹配或格式错误时返回false
+	bool LoadFromFile(const FString& FilePath);
+
+	// 把清单写入文件
+	bool SaveToFile(const FString& FilePath) const;
+
+	// 合并另一份清单：峰值与未命中次数取较大值，首次请求时间取较小值
+	void Merge(const FTireflyActorPoolManifest& Other);
+};
@@ -0,0 +1,85 @@
+// Copyright Tirefly. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "TireflyActorPoolSettings.generated.h"
+
+
+class AGameModeBase;
+class UDataLayerAsset;
+class UTireflyActorPoolConfig;
+
+
+
+// Actor对象池的项目设置，可以通过平台配置文件为不同平台指定不同的值
+UCLASS(Config = Game, DefaultConfig, Meta = (DisplayName = "Tirefly Actor Pool"))
+class TIREFLYACTORPOOL_API UTireflyActorPoolSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
+
+public:
+	// 分帧预热每帧可以使用的时间预算（毫秒）
+	UPROPERTY(Config, EditAnywhere, Category = "WarmUp", Meta = (ClampMin = "0", Units = "ms"))
+	float WarmUpFrameBudgetMs = 2.f;
+
+	// 每帧最多即时生成的Actor数量，超出后延迟生成请求会排队到之后几帧，小于等于0表示不限制
+	UPROPERTY(Config, EditAnywhere, Category = "Spawn Budget", Meta = (ClampMin = "0"))
+	int32 ColdSpawnFrameBudgetCount = 0;
+
+	// 每帧即时生成可以使用的时间预算（毫秒），小于等于0表示不限制
+	UPROPERTY(Config, EditAnywhere, Category = "Spawn Budget", Meta = (ClampMin = "0", Units = "ms"))
+	float ColdSpawnFrameBudgetMs = 0.f;
+
+	// 可放弃的延迟生成请求最多等待的时间（秒），超时后请求被放弃，小于等于0表示超出预算时立即放弃
+	UPROPERTY(Config, EditAnywhere, Category = "Spawn Budget", Meta = (ClampMin = "0", Units = "s"))
+	float DeferredSpawnDropTimeout = 0.5f;
+
+	// 是否在世界开始运行时自动应用对象池配置
+	UPROPERTY(Config, EditAnywhere, Category = "Pool Config")
+	bool bApplyPoolConfigOnWorldBeginPlay = true;
+
+	// 所有地图都会应用的对象池配置
+	UPROPERTY(Config, EditAnywhere, Category = "Pool Config")
+	TSoftObjectPtr<UTireflyActorPoolConfig> DefaultPoolConfig;
+
+	// 指定地图额外应用的对象池配置，同一对象池的配置会覆盖默认配置
+	UPROPERTY(Config, EditAnywhere, Category = "Pool Config")
+	TMap<TSoftObjectPtr<UWorld>, TSoftObjectPtr<UTireflyActorPoolConfig>> MapPoolConfigs;
+
+	// 指定游戏模式（包括其子类）额外应用的对象池配置，同一对象池的配置会覆盖默认配置和地图配置
+	UPROPERTY(Config, EditAnywhere, Category = "Pool Config")
+	TMap<TSoftClassPtr<AGameModeBase>, TSoftObjectPtr<UTireflyActorPoolConfig>> GameModePoolConfigs;
+
+	// 流送关卡（子关卡）为对象池保留的配置：关卡开始流送时预热对象池，卸载后释放保留的待命Actor
+	UPROPERTY(Config, EditAnywhere, Category = "Pool Config|Streaming")
+	TMap<TSoftObjectPtr<UWorld>, TSoftObjectPtr<UTireflyActorPoolConfig>> StreamingLevelPoolConfigs;
+
+	// World Partition数据层为对象池保留的配置：数据层加载时预热对象池，卸载后释放保留的待命Actor
+	UPROPERTY(Config, EditAnywhere, Category = "Pool Config|Streaming")
+	TMap<TSoftObjectPtr<UDataLayerAsset>, TSoftObjectPtr<UTireflyActorPoolConfig>> DataLayerPoolConfigs;
+
+	// 是否在试玩时记录各个对象池的使用情况，并在世界结束时写入地图对应的使用情况清单（Shipping版本中不会记录）
+	UPROPERTY(Config, EditAnywhere, Category = "Usage Manifest")
+	bool bRecordUsageManifest = false;
+
+	// 是否在世界开始运行时根据地图的使用情况清单预热对象池，预热数量会补足到记录的峰值
+	UPROPERTY(Config, EditAnywhere, Category = "Usage Manifest")
+	bool bApplyUsageManifest = true;
+
+	// 使用情况清单的存放目录，相对于项目目录，打包时需要把该目录加入额外的非资产目录中
+	UPROPERTY(Config, EditAnywhere, Category = "Usage Manifest")
+	FString UsageManifestDirectory = TEXT("Config/TireflyActorPoolManifests");
+
+	// 根据使用情况清单预热时使用的最高优先级，首次请求越晚的对象池优先级越低
+	UPROPERTY(Config, EditAnywhere, Category = "Usage Manifest")
+	int32 UsageManifestWarmUpPriority = 0;
+
+	// 地图切换后重新预热持久对象池时使用的优先级
+	UPROPERTY(Config, EditAnywhere, Category = "Persistence")
+	int32 PersistentPoolWarmUpPriority = 1;
+};
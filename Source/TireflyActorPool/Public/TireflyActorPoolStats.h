@@ -0,0 +1,60 @@
+// Copyright Tirefly. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+
+
+// 对象池的统计组，通过“stat TireflyActorPool”查看
+DECLARE_STATS_GROUP(TEXT("TireflyActorPool"), STATGROUP_TireflyActorPool, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spawn Actor"), STAT_TireflyActorPool_SpawnActor, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spawn Actors"), STAT_TireflyActorPool_SpawnActors, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Recycle Actor"), STAT_TireflyActorPool_RecycleActor, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Recycle All Active Actors"), STAT_TireflyActorPool_RecycleAllActiveActors, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Warm Up Actor Pool"), STAT_TireflyActorPool_WarmUpActorPool, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tick Warm Up Queue"), STAT_TireflyActorPool_TickWarmUpQueue, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tick Pending Commands"), STAT_TireflyActorPool_TickPendingCommands, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tick Actor Lifetimes"), STAT_TireflyActorPool_TickActorLifetimes, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tick Actor Pool Tiering"), STAT_TireflyActorPool_TickActorPoolTiering, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tick Actor Pool Proxies"), STAT_TireflyActorPool_TickActorPoolProxies, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tick Deferred Spawn Queue"), STAT_TireflyActorPool_TickDeferredSpawnQueue, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Generic Begin Play"), STAT_TireflyActorPool_GenericBeginPlay, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Generic End Play"), STAT_TireflyActorPool_GenericEndPlay, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pool Hits"), STAT_TireflyActorPool_Hits, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pool Misses"), STAT_TireflyActorPool_Misses, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cold Spawns"), STAT_TireflyActorPool_ColdSpawns, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Recycles"), STAT_TireflyActorPool_Recycles, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cold Tier Freezes"), STAT_TireflyActorPool_Freezes, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cold Tier Thaws"), STAT_TireflyActorPool_Thaws, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Proxy Dehydrations"), STAT_TireflyActorPool_Dehydrations, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Proxy Hydrations"), STAT_TireflyActorPool_Hydrations, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Deferred Spawns"), STAT_TireflyActorPool_DeferredSpawns, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Dropped Spawns"), STAT_TireflyActorPool_DroppedSpawns, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Idle Actors"), STAT_TireflyActorPool_IdleActors, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Active Actors"), STAT_TireflyActorPool_ActiveActors, STATGROUP_TireflyActorPool, TIREFLYACTORPOOL_API);
+
+// 对象池的CSV统计类别，通过“csvprofile start”或启动参数“-csvCategories=TireflyActorPool”采集
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(TIREFLYACTORPOOL_API, TireflyActorPool);
+
+// 对象池的Unreal Insights追踪频道，通过启动参数“-trace=cpu,TireflyActorPool”开启
+UE_TRACE_CHANNEL_EXTERN(TireflyActorPoolChannel, TIREFLYACTORPOOL_API);
+
+
+
+// 同时记录统计组、Insights追踪和CSV的作用域计时，StatName为STAT_TireflyActorPool_后面的部分
+#define TIREFLY_ACTOR_POOL_SCOPE_CYCLE_COUNTER(StatName) \
+	SCOPE_CYCLE_COUNTER(STAT_TireflyActorPool_##StatName); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("TireflyActorPool::" #StatName, TireflyActorPoolChannel); \
+	CSV_SCOPED_TIMING_STAT(TireflyActorPool, StatName)
+
+// 同时累加统计组计数器和CSV自定义统计
+#define TIREFLY_ACTOR_POOL_INC_COUNTER(StatName, Amount) \
+	INC_DWORD_STAT_BY(STAT_TireflyActorPool_##StatName, Amount); \
+	CSV_CUSTOM_STAT(TireflyActorPool, StatName, static_cast<int32>(Amount), ECsvCustomStatOp::Accumulate)
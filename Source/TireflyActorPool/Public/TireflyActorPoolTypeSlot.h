@@ -0,0 +1,37 @@
+// Copyright Tirefly. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "TireflyPoolingActorInterface.h"
+
+
+
+// 为C++类型对象池分配密集的类型槽位
+struct TIREFLYACTORPOOL_API FTireflyActorPoolTypeSlots
+{
+	// 分配一个新的类型槽位，可以在任意线程上调用
+	static int32 Allocate();
+};
+
+
+
+/**
+ * C++类型T在类型对象池中的槽位，第一次使用时分配，之后保持不变
+ *
+ * 槽位只是对象池子系统中T的Class池的索引缓存：同一个类型在不同模块中分别实例化时可能得到不同的槽位，
+ * 但它们都会绑定到同一个Class池上。
+ */
+template<typename T>
+struct TTireflyActorPoolTypeSlot
+{
+	static_assert(TIsDerivedFrom<T, AActor>::Value, "Typed actor pools require an AActor subclass.");
+	static_assert(TIsDerivedFrom<T, ITireflyPoolingActorInterface>::Value, "Typed actor pools require a class that implements ITireflyPoolingActorInterface in C++.");
+
+	static int32 Get()
+	{
+		static const int32 Slot = FTireflyActorPoolTypeSlots::Allocate();
+		return Slot;
+	}
+};
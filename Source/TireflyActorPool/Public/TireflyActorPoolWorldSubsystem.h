@@ -4,10 +4,386 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "Containers/Queue.h"
+#include "Engine/StreamableManager.h"
 #include "StructUtils/InstancedStruct.h"
+#include "TireflyActorLifetimeWheel.h"
+#include "TireflyActorPoolTypeSlot.h"
+#include "TireflyActorStateSnapshot.h"
+#include "TireflyPoolingActorTypedInit.h"
+#include "WorldPartition/DataLayer/DataLayerType.h"
 #include "TireflyActorPoolWorldSubsystem.generated.h"
 
 
+class UDataLayerInstance;
+class UInstancedStaticMeshComponent;
+class ULevelStreaming;
+class UStaticMesh;
+class UTireflyActorPoolConfig;
+struct FTireflyActorPoolConfigEntry;
+
+
+
+// 分帧预热任务完成时的回调
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FTireflyActorPoolWarmUpCompletedDelegate, int32, WarmUpHandle, TSubclassOf<AActor>, ActorClass, FName, ActorId);
+
+
+
+// Actor对象池的分帧预热任务
+struct FTireflyActorPoolWarmUpJob
+{
+	// 任务句柄
+	int32 Handle = INDEX_NONE;
+
+	// 对象池的目标类型
+	TWeakObjectPtr<UClass> ActorClass;
+
+	// 对象池的目标Id
+	FName ActorId = NAME_None;
+
+	// 需要预热的Actor数量
+	int32 TotalCount = 0;
+
+	// 已经处理的Actor数量
+	int32 ProcessedCount = 0;
+
+	// 任务优先级，数值越大越先执行
+	int32 Priority = 0;
+
+	// 任务完成时的回调
+	FSimpleDelegate OnCompleted;
+};
+
+
+
+// 超出每帧即时生成预算、延迟到之后几帧完成的生成请求
+struct FTireflyActorPoolDeferredSpawn
+{
+	// 请求句柄
+	int32 Handle = INDEX_NONE;
+
+	// 要生成的Actor类型
+	TWeakObjectPtr<UClass> ActorClass;
+
+	// 要生成的Actor的Id标识
+	FName ActorId = NAME_None;
+
+	// 要生成的Actor的初始化世界坐标系下的Transform
+	FTransform Transform;
+
+	// Actor实例的初始化数据，无效的InstancedStruct表示不初始化
+	FInstancedStruct InitialData;
+
+	// 生成的Actor的存活时间
+	float Lifetime = -1.f;
+
+	// 生成Actor时的初始碰撞处理方式
+	ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	// 要生成的Actor的Owner，提交请求后被销毁时请求失败
+	TWeakObjectPtr<AActor> Owner;
+
+	// 要生成的Actor的Instigator，提交请求后被销毁时请求失败
+	TWeakObjectPtr<APawn> Instigator;
+
+	// 请求优先级，数值越大越先执行
+	int32 Priority = 0;
+
+	// 是否可以在负载过高时放弃
+	bool bDroppable = false;
+
+	// 提交请求的世界时间
+	double RequestTime = 0.0;
+
+	// 生成完成后的回调，生成失败或请求被放弃时参数为空
+	TFunction<void(AActor*)> OnSpawned;
+};
+
+
+
+// 从任意线程提交、在游戏线程上批量执行的对象池命令
+struct FTireflyActorPoolCommand
+{
+	enum class EType : uint8
+	{
+		Spawn,
+		Recycle,
+	};
+
+	EType Type = EType::Spawn;
+
+	// 要生成的Actor类型
+	TWeakObjectPtr<UClass> ActorClass;
+
+	// 要生成的Actor的Id标识
+	FName ActorId = NAME_None;
+
+	// 要生成的Actor的初始化世界坐标系下的Transform
+	FTransform Transform;
+
+	// Actor实例的初始化数据，无效的InstancedStruct表示不初始化
+	FInstancedStruct InitialData;
+
+	// 生成的Actor的存活时间
+	float Lifetime = -1.f;
+
+	// 生成Actor时的初始碰撞处理方式
+	ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	// 要生成的Actor的Owner
+	TWeakObjectPtr<AActor> Owner;
+
+	// 要生成的Actor的Instigator
+	TWeakObjectPtr<APawn> Instigator;
+
+	// 要回收的Actor
+	TWeakObjectPtr<AActor> Actor;
+
+	// 生成完成后在游戏线程上执行的回调，生成失败时参数为空
+	TFunction<void(AActor*)> OnSpawned;
+};
+
+
+
+/**
+ * 对象池的句柄，通过UTireflyActorPoolWorldSubsystem::FindOrCreatePool解析一次后可以反复使用，
+ * 之后的生成、回收和预热直接定位到对象池而不再按Actor类型或Id查找。
+ * 对象池被清理后句柄失效，即使对象池的位置被新的对象池复用也不会指向新的对象池
+ */
+struct FTireflyActorPoolKey
+{
+	// 句柄是否曾经解析成功，不代表对象池仍然存在
+	bool IsSet() const { return PoolIndex != INDEX_NONE; }
+
+	bool operator==(const FTireflyActorPoolKey& Other) const
+	{
+		return PoolIndex == Other.PoolIndex && Serial == Other.Serial;
+	}
+
+	bool operator!=(const FTireflyActorPoolKey& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	// 对象池在子系统中的位置
+	int32 PoolIndex = INDEX_NONE;
+
+	// 对象池创建时分配的序号，用于识别位置被复用的情况
+	uint32 Serial = 0;
+};
+
+
+
+/**
+ * 对象池Actor按类型分组的组件列表，在Actor第一次激活/停用时构建并保存在Actor的记录中，
+ * 之后的激活/停用直接遍历分组，不再获取、排序和逐个判断组件类型。Actor拥有的组件数量变化时重新构建
+ */
+struct FTireflyPooledActorComponents
+{
+	// 一个组件及其在构建时记录的标记
+	struct FEntry
+	{
+		TWeakObjectPtr<UActorComponent> Component;
+
+		// 组件是否自动激活，不自动激活的特效和普通组件在Actor复用时保持未激活，与新生成的Actor一致
+		bool bAutoActivate = false;
+
+		// 组件是否开启过物理模拟，从未开启过的组件跳过清除速度等物理调用
+		bool bPhysicsEverEnabled = false;
+	};
+
+	// 构建时Actor拥有的组件数量，运行时添加或移除组件后与Actor不一致，需要重新构建
+	int32 OwnedComponentNum = INDEX_NONE;
+
+	TArray<FEntry> ParticleSystems;
+	TArray<FEntry> Niagaras;
+	TArray<FEntry> Primitives;
+	TArray<FEntry> Movements;
+
+	// Movements中的投射物移动组件，激活时需要重新设置初速度
+	TArray<FEntry> ProjectileMovements;
+	TArray<FEntry> Others;
+};
+
+
+
+// 对象池为由它生成的Actor保存的记录
+struct FTireflyPooledActorRecord
+{
+	// 生成Actor的对象池，回收时直接回到这个对象池
+	FTireflyActorPoolKey HomePool;
+
+	// 回收时用于重置属性的快照
+	TUniquePtr<FTireflyActorStateSnapshot> Snapshot;
+
+	// Actor转为冷待命时处于注册状态的组件，恢复为热待命时只重新注册它们
+	TArray<TWeakObjectPtr<UActorComponent>> RegisteredComponentsWhenCold;
+
+	// Actor转为冷待命时仍处于激活状态的组件，重新注册后只有它们保持激活
+	TArray<TWeakObjectPtr<UActorComponent>> ActiveComponentsWhenCold;
+
+	/**
+	 * 激活/停用时使用的组件列表，由UTireflyActorPoolLibrary的通用函数构建
+	 * 以共享引用持有：组件的激活回调可能重入并重新构建列表，正在遍历的列表保持有效
+	 */
+	TSharedPtr<FTireflyPooledActorComponents, ESPMode::NotThreadSafe> Components;
+
+	// Actor激活期间所在的对象池在ActorPools中的索引，待命时为INDEX_NONE
+	int32 ActivePoolIndex = INDEX_NONE;
+
+	// Actor在对象池ActiveActors中的位置，用于O(1)移除
+	int32 ActiveSlot = INDEX_NONE;
+
+	// 使用代理的对象池复制的初始化数据，Actor被替换为代理后重新生成时使用
+	FInstancedStruct ProxyInitialData;
+
+	// Actor是否以C++类型化的初始化数据生成，这种数据不归对象池持有，Actor不会被替换为代理
+	bool bTypedInitialData = false;
+};
+
+
+
+// 代替被回收的远处Actor显示的代理，记录重新生成Actor时需要恢复的内容
+struct FTireflyActorPoolProxy
+{
+	// 重新生成Actor时使用的Transform
+	FTransform ActorTransform;
+
+	// 存活时间到期的世界时间，-1表示一直存活；代理期间照常计时，到期的代理直接移除
+	double ExpireTime = -1.0;
+
+	// 被回收的Actor的Owner
+	TWeakObjectPtr<AActor> Owner;
+
+	// 被回收的Actor的Instigator
+	TWeakObjectPtr<APawn> Instigator;
+
+	// 被回收的Actor的初始化数据
+	FInstancedStruct InitialData;
+};
+
+
+
+// 流送关卡、数据层等内容为一个对象池保留的待命Actor
+struct FTireflyActorPoolReservation
+{
+	// 保留的唯一标识，用于识别异步加载完成前已经释放的保留
+	int32 ReservationId = INDEX_NONE;
+
+	// 对象池的目标类型
+	TSoftClassPtr<AActor> ActorClass;
+
+	// 对象池的目标Id
+	FName ActorId = NAME_None;
+
+	// 保留的待命Actor数量
+	int32 Count = 0;
+
+	// 预热保留的待命Actor时使用的优先级
+	int32 WarmUpPriority = 0;
+
+	// 保留的对象池，Actor类型加载完成并计入对象池之后才有效
+	FTireflyActorPoolKey PoolKey;
+
+	// 为保留排队的分帧预热任务
+	int32 WarmUpHandle = INDEX_NONE;
+};
+
+
+
+// Actor对象池的容量与裁剪策略
+USTRUCT(BlueprintType)
+struct FTireflyActorPoolPolicy
+{
+	GENERATED_BODY()
+
+public:
+	// 对象池中最多保留的待命Actor数量，超出后回收的Actor会被直接销毁，小于等于0表示不限制
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capacity")
+	int32 MaxIdleCount = 0;
+
+	// 闲置裁剪时对象池中至少保留的待命Actor数量
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capacity", Meta = (ClampMin = "0"))
+	int32 MinIdleCount = 0;
+
+	// 待命Actor在对象池中闲置超过该时间（秒）后会被裁剪销毁，小于等于0表示不裁剪
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Trim")
+	float IdleTimeout = 0.f;
+
+	// 每帧最多从该对象池中裁剪销毁的Actor数量
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Trim", Meta = (ClampMin = "1"))
+	int32 MaxTrimPerFrame = 4;
+
+	// 对象池中的待命Actor少于该数量时，会通过分帧预热在之后几帧内补充，小于等于0表示不自动补充
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replenish")
+	int32 LowWatermark = 0;
+
+	// 自动补充的目标待命数量，不会小于LowWatermark
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replenish", Meta = (ClampMin = "0"))
+	int32 ReplenishTarget = 0;
+
+	// 是否根据需求的移动平均自动提高补充目标：目标至少为“每秒平均需求 × AdaptiveDemandWindow”
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replenish")
+	bool bAdaptiveReplenishTarget = false;
+
+	// 自适应补充目标需要覆盖的需求时长（秒）
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replenish", Meta = (ClampMin = "0", EditCondition = "bAdaptiveReplenishTarget"))
+	float AdaptiveDemandWindow = 1.f;
+
+	// 自动补充使用的预热任务优先级，默认低于手动预热
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replenish")
+	int32 ReplenishPriority = -1;
+
+	// 是否在回收时自动把Actor的属性重置为第一次生成时的状态，只会复制发生了变化的属性，只对开启后新生成的Actor生效
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Reset")
+	bool bResetStateOnRecycle = false;
+
+	// 是否延迟构建即时生成的Actor：在FinishSpawning（构造脚本和BeginPlay）之前应用ActorId和初始化数据，避免初始化两次
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn")
+	bool bDeferredColdSpawn = false;
+
+	// 保持热待命（组件已注册，可以立即取用）的待命Actor数量上限，超出部分中闲置最久的Actor会转为冷待命，小于等于0表示不限制
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tier")
+	int32 MaxHotIdleCount = 0;
+
+	// 热待命Actor闲置超过该时间（秒）后转为冷待命，注销所有组件并释放渲染与物理状态，小于等于0表示不按闲置时间转换
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tier")
+	float ColdIdleTimeout = 0.f;
+
+	// 按闲置时间转为冷待命时至少保留的热待命Actor数量，热待命Actor少于该数量时会在之后几帧内把冷待命Actor重新注册为热待命
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tier", Meta = (ClampMin = "0"))
+	int32 MinHotIdleCount = 0;
+
+	// 每帧最多在冷热待命之间转换的Actor数量
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tier", Meta = (ClampMin = "1"))
+	int32 MaxTierChangesPerFrame = 4;
+
+	// 是否在地图切换后保留对象池：Actor类型在切换期间保持加载，新地图开始运行时按原有的规模重新预热
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Persistence")
+	bool bPersistAcrossTravel = false;
+
+	// 是否把远离所有玩家视点的激活Actor回收，并以共享的实例化静态网格体代理代替显示，玩家靠近时再从对象池中重新生成Actor
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Proxy")
+	bool bUseInstancedProxy = false;
+
+	// 激活的Actor与最近的玩家视点的距离超过该值时替换为代理
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Proxy", Meta = (ClampMin = "0", EditCondition = "bUseInstancedProxy"))
+	float ProxyDistance = 5000.f;
+
+	// 代理与最近的玩家视点的距离小于ProxyDistance减去该值时才重新生成Actor，避免在边界附近反复切换
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Proxy", Meta = (ClampMin = "0", EditCondition = "bUseInstancedProxy"))
+	float ProxyHysteresis = 500.f;
+
+	// 代理使用的静态网格体，为空时使用Actor中第一个静态网格体组件的网格体和材质
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Proxy", Meta = (EditCondition = "bUseInstancedProxy"))
+	UStaticMesh* ProxyMesh = nullptr;
+
+	// 每帧最多在Actor与代理之间切换的数量
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Proxy", Meta = (ClampMin = "1", EditCondition = "bUseInstancedProxy"))
+	int32 MaxProxySwapsPerFrame = 8;
+};
+
+
 
 // Actor对象池
 USTRUCT()
@@ -16,113 +392,1395 @@ struct FTireflyActorPool
 	GENERATED_BODY()
 
 public:
+	// 把待命Actor放入对象池
+	void PushIdleActor(AActor* Actor, double Time)
+	{
+		ActorPool.Push(Actor);
+		IdleSinceTimes.Push(Time);
+	}
+
+	// 从对象池中取出最近放入的待命Actor，热待命Actor取完后取出的是冷待命Actor
+	AActor* PopIdleActor()
+	{
+		IdleSinceTimes.Pop(EAllowShrinking::No);
+		AActor* Actor = ActorPool.Pop(EAllowShrinking::No);
+		NumColdIdle = FMath::Min(NumColdIdle, ActorPool.Num());
+		return Actor;
+	}
+
+	// 从对象池的尾部移除Count个待命Actor
+	void RemoveIdleActorsFromTop(int32 Count)
+	{
+		ActorPool.SetNum(ActorPool.Num() - Count, EAllowShrinking::No);
+		IdleSinceTimes.SetNum(IdleSinceTimes.Num() - Count, EAllowShrinking::No);
+		NumColdIdle = FMath::Min(NumColdIdle, ActorPool.Num());
+	}
+
+	// 从对象池的头部（闲置最久的一端）移除Count个待命Actor
+	void RemoveIdleActorsFromBottom(int32 Count)
+	{
+		ActorPool.RemoveAt(0, Count, EAllowShrinking::No);
+		IdleSinceTimes.RemoveAt(0, Count, EAllowShrinking::No);
+		NumColdIdle = FMath::Max(NumColdIdle - Count, 0);
+	}
+
+	// 移除指定的待命Actor，Actor不在对象池中时返回false
+	bool RemoveIdleActor(const AActor* Actor)
+	{
+		const int32 Index = ActorPool.Find(const_cast<AActor*>(Actor));
+		if (Index == INDEX_NONE)
+		{
+			return false;
+		}
+
+		ActorPool.RemoveAt(Index, 1, EAllowShrinking::No);
+		IdleSinceTimes.RemoveAt(Index, 1, EAllowShrinking::No);
+		if (Index < NumColdIdle)
+		{
+			--NumColdIdle;
+		}
+		return true;
+	}
+
+	void Empty()
+	{
+		ActorPool.Empty();
+		IdleSinceTimes.Empty();
+		NumColdIdle = 0;
+	}
+
+	// 热待命Actor的数量
+	int32 GetNumHotIdle() const
+	{
+		return ActorPool.Num() - NumColdIdle;
+	}
+
+	// 记录一次对象池请求：请求了Count个Actor，其中FetchedNum个来自待命Actor
+	void RecordDemand(int32 Count, int32 FetchedNum, double Time)
+	{
+		DemandThisFrame += Count;
+		MissCount += Count - FetchedNum;
+		HitCount += FetchedNum;
+		if (FirstDemandTime < 0.0)
+		{
+			FirstDemandTime = Time;
+		}
+	}
+
+public:
+	// 待命的Actor，越靠后的Actor越晚进入对象池
 	UPROPERTY()
 	TArray<AActor*> ActorPool;
+
+	// 从对象池中取出且尚未回收的Actor，无序紧凑排列，每个Actor的位置记录在它的FTireflyPooledActorRecord中
+	UPROPERTY()
+	TArray<AActor*> ActiveActors;
+
+	// 与ActorPool一一对应，记录每个待命Actor进入对象池的世界时间
+	TArray<double> IdleSinceTimes;
+
+	// 显示远处Actor的实例化静态网格体代理，第一次需要代理时创建
+	UPROPERTY()
+	UInstancedStaticMeshComponent* ProxyComponent = nullptr;
+
+	// 与ProxyComponent的实例一一对应，记录每个代理重新生成Actor时需要恢复的内容，移除时与实例一样由末尾填补
+	TArray<FTireflyActorPoolProxy> Proxies;
+
+	// Actor和策略都没有可用的网格体，不再尝试替换为代理，直到策略被重新设置
+	bool bProxyUnavailable = false;
+
+	// 下一帧开始检查是否需要替换为代理的激活Actor的位置，保证每个激活Actor都能轮到
+	int32 ProxyScanCursor = 0;
+
+	// ActorPool头部的冷待命Actor数量，冷待命Actor的组件已注销，不占用渲染场景和物理场景
+	int32 NumColdIdle = 0;
+
+	// 当前已加载的流送关卡、数据层等内容为对象池保留的待命Actor数量，闲置裁剪不会低于该数量
+	int32 ReservedCount = 0;
+
+	// 保留被释放后尚未销毁的待命Actor数量，裁剪时逐帧销毁
+	int32 PendingReleaseCount = 0;
+
+	// 对象池的容量与裁剪策略
+	UPROPERTY()
+	FTireflyActorPoolPolicy Policy;
+
+	// 对象池对应的Actor类型，Id对象池记录的是最近一次使用的类型
+	UPROPERTY()
+	TSubclassOf<AActor> ActorClass;
+
+	// Id对象池的Id，Class对象池为NAME_None
+	UPROPERTY()
+	FName ActorId = NAME_None;
+
+	// 对象池创建时分配的序号，0表示对象池已被清理
+	uint32 Serial = 0;
+
+	// 本帧向对象池请求Actor的次数
+	int32 DemandThisFrame = 0;
+
+	// 每秒请求次数的指数移动平均
+	float DemandRateAverage = 0.f;
+
+	// 正在进行的自动补充预热任务的句柄
+	int32 ReplenishWarmUpHandle = INDEX_NONE;
+
+	// ActiveActors数量的峰值，在Actor登记为激活时更新
+	int32 PeakActiveCount = 0;
+
+	// 从上一个世界恢复持久对象池时要求预热的数量，再次保存时不低于这个数量
+	int32 PersistentWarmUpCount = 0;
+
+	// 对象池中没有可用待命Actor、需要即时生成新Actor的次数
+	int32 MissCount = 0;
+
+	// 第一次向对象池请求Actor的世界时间，小于0表示还没有请求过
+	double FirstDemandTime = -1.0;
+
+	// 从待命Actor中取出Actor的次数
+	int32 HitCount = 0;
+
+	// 为对象池新生成Actor的次数，包括未命中时的即时生成和预热
+	int32 ColdSpawnCount = 0;
+
+	// 回收到对象池的次数，包括因对象池已满而销毁的Actor
+	int32 RecycleCount = 0;
+};
+
+
+
+// 组件与普通UObject的对象池，按对象的精确类型区分
+USTRUCT()
+struct FTireflyObjectPool
+{
+	GENERATED_BODY()
+
+public:
+	// 把待命对象放入对象池
+	void PushIdleObject(UObject* Object, double Time)
+	{
+		ObjectPool.Push(Object);
+		IdleSinceTimes.Push(Time);
+	}
+
+	// 从对象池中取出最近放入的待命对象
+	UObject* PopIdleObject()
+	{
+		IdleSinceTimes.Pop(EAllowShrinking::No);
+		return ObjectPool.Pop(EAllowShrinking::No);
+	}
+
+	// 从对象池的头部（闲置最久的一端）移除Count个待命对象
+	void RemoveIdleObjectsFromBottom(int32 Count)
+	{
+		ObjectPool.RemoveAt(0, Count, EAllowShrinking::No);
+		IdleSinceTimes.RemoveAt(0, Count, EAllowShrinking::No);
+	}
+
+public:
+	// 待命的对象，越靠后的对象越晚进入对象池
+	UPROPERTY()
+	TArray<UObject*> ObjectPool;
+
+	// 与ObjectPool一一对应，记录每个待命对象进入对象池的世界时间
+	TArray<double> IdleSinceTimes;
+
+	// 对象池的容量与裁剪策略，只有容量和裁剪相关的设置对组件和UObject对象池生效
+	UPROPERTY()
+	FTireflyActorPoolPolicy Policy;
+
+	// 从对象池中取出且尚未回收的对象数量
+	int32 ActiveCount = 0;
+
+	// ActiveCount的峰值
+	int32 PeakActiveCount = 0;
+
+	// 从待命对象中取出对象的次数
+	int32 HitCount = 0;
+
+	// 对象池中没有可用待命对象的次数
+	int32 MissCount = 0;
+
+	// 为对象池新创建对象的次数，包括未命中时的即时创建和预热
+	int32 ColdSpawnCount = 0;
+
+	// 回收到对象池的次数，包括因对象池已满而销毁的对象
+	int32 RecycleCount = 0;
 };
 
 
 
-// 基于世界子系统的Actor对象池子系统
-UCLASS()
-class TIREFLYACTORPOOL_API UTireflyActorPoolWorldSubsystem : public UWorldSubsystem
-{
-	GENERATED_BODY()
+// 对象池的运行统计
+USTRUCT(BlueprintType)
+struct FTireflyActorPoolStats
+{
+	GENERATED_BODY()
+
+	// 对象池中待命Actor的数量
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int32 IdleCount = 0;
+
+	// 待命Actor中冷待命（组件已注销）的数量
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int32 ColdIdleCount = 0;
+
+	// 以实例化静态网格体代理显示的远处Actor数量
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int32 ProxyCount = 0;
+
+	// 从对象池中取出且尚未回收的Actor数量
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int32 ActiveCount = 0;
+
+	// 激活Actor数量的峰值
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int32 PeakActiveCount = 0;
+
+	// 从待命Actor中取出Actor的次数
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int32 HitCount = 0;
+
+	// 对象池中没有可用待命Actor的次数
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int32 MissCount = 0;
+
+	// 为对象池新生成Actor的次数
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int32 ColdSpawnCount = 0;
+
+	// 回收到对象池的次数
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	int32 RecycleCount = 0;
+
+	// 命中率，没有请求过时为0
+	UPROPERTY(BlueprintReadOnly, Category = "Stats")
+	float HitRate = 0.f;
+};
+
+
+
+/**
+ * 基于世界子系统的Actor对象池子系统
+ *
+ * 除了EnqueueSpawnActorFromPool和EnqueueRecycleActorToPool之外，所有接口都只能在游戏线程上调用，对象池本身不加锁。
+ * 其他线程（异步任务、物理回调、Mass处理器等）通过无锁的多生产者单消费者命令队列提交生成与回收请求，
+ * 子系统在每帧Tick开始时批量执行。
+ */
+UCLASS()
+class TIREFLYACTORPOOL_API UTireflyActorPoolWorldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+#pragma region WorldSubsystem
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+#pragma endregion
+
+
+#pragma region ActorPool_Command
+
+public:
+	/**
+	 * 从任意线程提交从对象池中生成Actor的请求，请求会在下一次Tick开始时在游戏线程上执行，提交时不会加锁
+	 *
+	 * @param ActorClass 要生成的Actor类型
+	 * @param ActorId 要生成的Actor的Id标识
+	 * @param Transform 要生成的Actor的初始化世界坐标系下的Transform
+	 * @param InitialData Actor实例的初始化数据，无效的InstancedStruct表示不初始化
+	 * @param Lifetime 生成的Actor的存活时间，默认为-1，表示一直存活
+	 * @param CollisionHandling 生成Actor时的初始碰撞处理方式，默认为AlwaysSpawn
+	 * @param Owner 要生成的Actor的Owner，默认为空
+	 * @param Instigator 要生成的Actor的Instigator，默认为空
+	 * @param OnSpawned 生成完成后在游戏线程上执行的回调，生成失败时参数为空
+	 */
+	void EnqueueSpawnActorFromPool(
+		TSubclassOf<AActor> ActorClass,
+		FName ActorId,
+		const FTransform& Transform,
+		FInstancedStruct InitialData = FInstancedStruct(),
+		float Lifetime = -1.f,
+		const ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn,
+		AActor* Owner = nullptr,
+		APawn* Instigator = nullptr,
+		TFunction<void(AActor*)>&& OnSpawned = nullptr);
+
+	// 从任意线程提交把Actor回收到对象池的请求，请求会在下一次Tick开始时在游戏线程上执行，提交时不会加锁
+	void EnqueueRecycleActorToPool(AActor* Actor);
+
+protected:
+	// 在游戏线程上批量执行其他线程提交的命令
+	void TickPendingCommands();
+
+	void ExecuteCommand(FTireflyActorPoolCommand& Command);
+
+private:
+	// 其他线程提交的命令
+	TQueue<FTireflyActorPoolCommand, EQueueMode::Mpsc> PendingCommands;
+
+	// 本帧取出的命令，命令执行时提交的新命令留到下一帧
+	TArray<FTireflyActorPoolCommand> DrainedCommands;
+
+#pragma endregion
+
+
+#pragma region ActorPool_Clear
+
+public:
+	// 清理所有Actor池
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	void ClearAllActorPools();
+
+	// 清理指定类型的Actor池
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (DisplayName = "Clear Actor Pools (Class)"))
+	void ClearActorPoolsOfClass(TSubclassOf<AActor> ActorClass);
+
+	// 清理指定Id的Actor池
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (DisplayName = "Clear Actor Pools (Id)"))
+	void ClearActorPoolOfId(FName ActorId);
+
+#pragma endregion
+
+
+#pragma region ActorPool_Key
+
+public:
+	/**
+	 * 查找或创建对象池并返回它的句柄，之后可以用句柄代替Actor类型和Id调用生成、回收和预热
+	 *
+	 * @param ActorClass 对象池的Actor类型，必须实现ITireflyPoolingActorInterface
+	 * @param ActorId 对象池的Id，为NAME_None时返回Actor类型的Class池
+	 * @return 对象池的句柄，参数无效时返回未设置的句柄
+	 */
+	FTireflyActorPoolKey FindOrCreatePool(TSubclassOf<AActor> ActorClass, FName ActorId = NAME_None);
+
+	// 句柄对应的对象池是否仍然存在
+	bool IsActorPoolKeyValid(const FTireflyActorPoolKey& PoolKey) const { return ResolveActorPoolIndex(PoolKey) != INDEX_NONE; }
+
+	// 获取Actor所属对象池的句柄，Actor不是由对象池生成的或对象池已被清理时返回未设置的句柄
+	FTireflyActorPoolKey GetHomeActorPool(const AActor* Actor) const;
+
+protected:
+	AActor* SpawnActorFromPoolKey_Internal(
+		const FTireflyActorPoolKey& PoolKey,
+		const FTransform& Transform,
+		const FTireflyPoolingInitialDataRef& InitialData,
+		float Lifetime,
+		const ESpawnActorCollisionHandlingMethod CollisionHandling,
+		AActor* Owner,
+		APawn* Instigator);
+
+private:
+	// 下一个被创建的对象池的序号
+	uint32 NextActorPoolSerial = 1;
+
+#pragma endregion
+
+
+#pragma region ActorPool_Policy
+
+public:
+	// 设置指定类型的Actor池的容量与裁剪策略，如果对象池中的待命Actor超出新的容量上限，超出的部分会被立即销毁
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (DisplayName = "Set Actor Pool Policy (Class)"))
+	void SetActorPoolPolicyOfClass(TSubclassOf<AActor> ActorClass, const FTireflyActorPoolPolicy& Policy);
+
+	// 设置指定Id的Actor池的容量与裁剪策略，如果对象池中的待命Actor超出新的容量上限，超出的部分会被立即销毁
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (DisplayName = "Set Actor Pool Policy (Id)"))
+	void SetActorPoolPolicyOfId(FName ActorId, const FTireflyActorPoolPolicy& Policy);
+
+	// 获取指定类型的Actor池的容量与裁剪策略，如果对象池不存在则返回默认策略
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool", Meta = (DisplayName = "Get Actor Pool Policy (Class)"))
+	FTireflyActorPoolPolicy GetActorPoolPolicyOfClass(TSubclassOf<AActor> ActorClass) const;
+
+	// 获取指定Id的Actor池的容量与裁剪策略，如果对象池不存在则返回默认策略
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool", Meta = (DisplayName = "Get Actor Pool Policy (Id)"))
+	FTireflyActorPoolPolicy GetActorPoolPolicyOfId(FName ActorId) const;
+
+protected:
+	// 销毁对象池中超出容量上限的待命Actor，优先销毁闲置最久的Actor
+	void EnforceActorPoolCapacity(FTireflyActorPool& Pool);
+
+	// 裁剪所有对象池中闲置超时的待命Actor
+	void TickActorPoolTrimming();
+
+	// 裁剪单个对象池中闲置超时的待命Actor，每帧最多裁剪Policy.MaxTrimPerFrame个
+	void TrimActorPool(FTireflyActorPool& Pool, double CurrentTime);
+
+	// 在所有对象池中转换待命Actor的冷热状态
+	void TickActorPoolTiering();
+
+	// 按策略把单个对象池中的热待命Actor转为冷待命，或把冷待命Actor重新注册为热待命，每帧最多转换Policy.MaxTierChangesPerFrame个
+	void TierActorPool(FTireflyActorPool& Pool, double CurrentTime);
+
+	// 把待命Actor转为冷待命：记录已注册和已激活的组件后注销所有组件，释放渲染状态和物理状态
+	void FreezeIdleActor(AActor* Actor);
+
+	// 把冷待命Actor重新注册为热待命：只注册冷待命之前已注册的组件，注册时被自动激活的组件会被重新停用
+	void ThawIdleActor(AActor* Actor);
+
+	// 对象池使用的世界时间
+	double GetPoolTime() const;
+
+	// 查找或创建对象池，并记录对象池对应的Actor类型
+	FTireflyActorPool& FindOrAddActorPool(const TSubclassOf<AActor>& ActorClass, FName ActorId);
+
+	// 查找或创建对象池，返回对象池在ActorPools中的索引
+	int32 FindOrAddActorPoolIndex(const TSubclassOf<AActor>& ActorClass, FName ActorId);
+
+	// 查找对象池，ActorId有效时查找Id池，否则查找Class池，对象池不存在时返回空
+	FTireflyActorPool* FindActorPool(const TSubclassOf<AActor>& ActorClass, FName ActorId);
+	const FTireflyActorPool* FindActorPool(const TSubclassOf<AActor>& ActorClass, FName ActorId) const;
+
+	// 销毁对象池中的待命Actor，并把对象池的位置留给之后创建的对象池复用
+	void ReleaseActorPool(int32 PoolIndex);
+
+	// 生成指向ActorPools中指定位置的对象池句柄
+	FTireflyActorPoolKey MakeActorPoolKey(int32 PoolIndex) const
+	{
+		return FTireflyActorPoolKey{ PoolIndex, ActorPools[PoolIndex].Serial };
+	}
+
+	// 获取句柄对应的对象池在ActorPools中的索引，句柄失效时返回INDEX_NONE
+	int32 ResolveActorPoolIndex(const FTireflyActorPoolKey& PoolKey) const
+	{
+		return ActorPools.IsValidIndex(PoolKey.PoolIndex) && PoolKey.Serial != 0 && ActorPools[PoolKey.PoolIndex].Serial == PoolKey.Serial
+			? PoolKey.PoolIndex
+			: INDEX_NONE;
+	}
+
+	// 更新所有对象池的需求移动平均，并为低于低水位线的对象池加入补充预热任务
+	void TickActorPoolReplenishment(float DeltaTime);
+
+	// 更新单个对象池的需求移动平均，并在需要时加入补充预热任务
+	void ReplenishActorPool(FTireflyActorPool& Pool, FName ActorId, float DeltaTime);
+
+#pragma endregion
+
+
+#pragma region ActorPool_Spawn
+
+protected:
+	AActor* FetchActorFromPool(int32 PoolIndex);
+
+	// 一次性从对象池中取出最多Count个Actor，追加到OutActors中，返回实际取出的数量
+	int32 FetchActorsFromPool(int32 PoolIndex, int32 Count, TArray<AActor*>& OutActors);
+
+	/**
+	 * 在对象池没有可用Actor时，直接在世界中生成一个新的Actor
+	 * 对象池开启了bDeferredColdSpawn时，PoolingBeginPlay和InitialData在FinishSpawning之前执行，并把InitialData置空、
+	 * bOutPoolingBeganPlay置为true，之后的激活操作不再重复调用
+	 */
+	AActor* SpawnNewActor_Internal(
+		UWorld* World,
+		const TSubclassOf<AActor>& ActorClass,
+		FName ActorId,
+		int32 PoolIndex,
+		const FTransform& Transform,
+		FTireflyPoolingInitialDataRef& InitialData,
+		const ESpawnActorCollisionHandlingMethod CollisionHandling,
+		AActor* Owner,
+		APawn* Instigator,
+		bool& bOutPoolingBeganPlay);
+
+	// 为新生成的Actor添加记录，对象池开启了bResetStateOnRecycle时同时捕获属性快照
+	void AddSpawnedActorRecord(AActor* Actor, int32 PoolIndex);
+
+	/**
+	 * 执行Actor从对象池中取出后的激活操作：登记为激活Actor、PoolingBeginPlay、PoolingInitialized以及生命周期
+	 * bPoolingBeganPlay为true时，PoolingBeginPlay已经在延迟生成中调用过
+	 */
+	void ActivateActor_Internal(
+		UWorld* World,
+		AActor* Actor,
+		int32 PoolIndex,
+		const FTireflyPoolingInitialDataRef& InitialData,
+		float Lifetime,
+		bool bPoolingBeganPlay);
+
+	// 从已确定的对象池中取出或新生成一个Actor并激活，调用前需要完成线程、世界和Actor类型的校验
+	AActor* SpawnActorFromPoolIndex_Internal(
+		UWorld* World,
+		const TSubclassOf<AActor>& ActorClass,
+		FName ActorId,
+		int32 PoolIndex,
+		const FTransform& Transform,
+		FTireflyPoolingInitialDataRef InitialData,
+		float Lifetime,
+		const ESpawnActorCollisionHandlingMethod CollisionHandling,
+		AActor* Owner,
+		APawn* Instigator);
+	
+	AActor* SpawnActor_Internal(
+		const TSubclassOf<AActor>& ActorClass,
+		FName ActorId,
+		const FTransform& Transform,
+		const FTireflyPoolingInitialDataRef& InitialData = {},
+		float Lifetime = -1.f,
+		const ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn,
+		AActor* Owner = nullptr,
+		APawn* Instigator = nullptr);
+
+	void SpawnActors_Internal(
+		const TSubclassOf<AActor>& ActorClass,
+		FName ActorId,
+		TConstArrayView<FTransform> Transforms,
+		TArray<AActor*>& OutActors,
+		TConstArrayView<FInstancedStruct> InitialData = {},
+		float Lifetime = -1.f,
+		const ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn,
+		AActor* Owner = nullptr,
+		APawn* Instigator = nullptr);
+
+	/**
+	 * 把生成的Actor转换为T，Id池中可能混有不同类型的Actor，类型不匹配时把Actor回收到对象池并返回空，
+	 * 避免Actor被激活后无人持有
+	 */
+	template<typename T>
+	T* CastSpawnedActor(AActor* Actor);
+
+	// 回收类型与请求的类型不匹配的Actor
+	void RecycleMismatchedActor(AActor* Actor, const UClass* ExpectedClass);
+
+public:
+	template<typename T>
+	T* SpawnActorFromPool(
+		TSubclassOf<T> ActorClass,
+		FName ActorId,
+		const FTransform& Transform,
+		const FInstancedStruct* InitialData = nullptr,
+		float Lifetime = -1.f,
+		const ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn,
+		AActor* Owner = nullptr,
+		APawn* Instigator = nullptr);
+
+	/**
+	 * 从句柄对应的对象池中生成Actor实例，不再按Actor类型或Id查找对象池，句柄失效时返回空
+	 *
+	 * @param PoolKey 通过FindOrCreatePool获取的对象池句柄
+	 * @param Transform 要生成的Actor的初始化世界坐标系下的Transform
+	 * @param InitialData Actor实例的初始化数据，为空表示不初始化
+	 * @param Lifetime 生成的Actor的存活时间，默认为-1，表示一直存活
+	 * @param CollisionHandling 生成Actor时的初始碰撞处理方式，默认为AlwaysSpawn
+	 * @param Owner 要生成的Actor的Owner，默认为空
+	 * @param Instigator 要生成的Actor的Instigator，默认为空
+	 */
+	template<typename T = AActor>
+	T* SpawnActorFromPool(
+		const FTireflyActorPoolKey& PoolKey,
+		const FTransform& Transform,
+		const FInstancedStruct* InitialData = nullptr,
+		float Lifetime = -1.f,
+		const ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn,
+		AActor* Owner = nullptr,
+		APawn* Instigator = nullptr);
+
+	/**
+	 * 从Actor对象池中生成Actor实例，并用C++类型化的初始化数据初始化，只供C++调用。
+	 * 初始化数据以常量引用直接传给TTireflyPoolingActorTypedInit<TInit>::PoolingInitializedTyped，
+	 * 不构造FInstancedStruct，也没有额外的内存分配和复制。T必须在C++中实现TTireflyPoolingActorTypedInit<TInit>（编译期检查）
+	 *
+	 * @param ActorClass 要生成的Actor类型
+	 * @param ActorId 要生成的Actor的Id标识
+	 * @param Transform 要生成的Actor的初始化世界坐标系下的Transform
+	 * @param InitialData Actor实例的初始化数据
+	 * @param Lifetime 生成的Actor的存活时间，默认为-1，表示一直存活
+	 * @param CollisionHandling 生成Actor时的初始碰撞处理方式，默认为AlwaysSpawn
+	 * @param Owner 要生成的Actor的Owner，默认为空
+	 * @param Instigator 要生成的Actor的Instigator，默认为空
+	 */
+	template<typename T, typename TInit, typename = std::enable_if_t<TireflyActorPool::TIsTypedInitialData<TInit>>>
+	T* SpawnActorFromPool(
+		TSubclassOf<T> ActorClass,
+		FName ActorId,
+		const FTransform& Transform,
+		const TInit& InitialData,
+		float Lifetime = -1.f,
+		const ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn,
+		AActor* Owner = nullptr,
+		APawn* Instigator = nullptr);
+
+	// 从句柄对应的对象池中生成Actor实例，并用C++类型化的初始化数据初始化，句柄失效时返回空
+	template<typename T, typename TInit, typename = std::enable_if_t<TireflyActorPool::TIsTypedInitialData<TInit>>>
+	T* SpawnActorFromPool(
+		const FTireflyActorPoolKey& PoolKey,
+		const FTransform& Transform,
+		const TInit& InitialData,
+		float Lifetime = -1.f,
+		const ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn,
+		AActor* Owner = nullptr,
+		APawn* Instigator = nullptr);
+
+	/**
+	 * 从Actor对象池中批量生成Actor实例，整个批次只校验一次Actor类型、只加锁一次、只查找一次对象池，
+	 * 池中不足的部分才会在世界中新生成
+	 *
+	 * @param ActorClass 要生成的Actor类型
+	 * @param ActorId 要生成的Actor的Id标识
+	 * @param Transforms 每个Actor的初始化世界坐标系下的Transform，生成的数量等于Transform的数量
+	 * @param OutActors 生成的Actor实例会按Transform的顺序追加到此数组中，生成失败的实例会被跳过
+	 * @param InitialData Actor实例的初始化数据，为空表示不初始化，只有1个元素表示所有实例共用，否则需要与Transforms一一对应
+	 * @param Lifetime 生成的Actor的存活时间，默认为-1，表示一直存活
+	 * @param CollisionHandling 生成Actor时的初始碰撞处理方式，默认为AlwaysSpawn
+	 * @param Owner 要生成的Actor的Owner，默认为空
+	 * @param Instigator 要生成的Actor的Instigator，默认为空
+	 */
+	template<typename T>
+	void SpawnActorsFromPool(
+		TSubclassOf<T> ActorClass,
+		FName ActorId,
+		TConstArrayView<FTransform> Transforms,
+		TArray<T*>& OutActors,
+		TConstArrayView<FInstancedStruct> InitialData = {},
+		float Lifetime = -1.f,
+		const ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn,
+		AActor* Owner = nullptr,
+		APawn* Instigator = nullptr);
+
+#pragma endregion
+
+
+#pragma region ActorPool_Recycle
+
+public:
+	/**
+	 * 把Actor回收到Actor池里，由对象池生成的Actor直接回到生成它的对象池，
+	 * 其他Actor如果有Id，
+	 * 并且Actor实现了 ITireflyPoolingActorInterface::GetActorId，
+	 * 则回到对应Id的Actor池，
+	 * 否则回到Actor类的Actor池。
+	 * 在游戏线程以外调用时会转交给命令队列，在下一次Tick时执行
+	 * 
+	 * @param Actor 要回收的Actor
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	void RecycleActorToPool(AActor* Actor);
+
+	// 把Actor回收到句柄对应的对象池中，句柄失效或Actor的类型与Class池不符时按RecycleActorToPool(Actor)处理
+	void RecycleActorToPool(AActor* Actor, const FTireflyActorPoolKey& PoolKey);
+
+protected:
+	// 把已经执行过PoolingEndPlay的Actor放回指定的对象池，对象池已满时直接销毁
+	void RecycleActorToPool_Internal(AActor* Actor, int32 PoolIndex, FTireflyPooledActorRecord* Record);
+
+	// Actor是否已经在对象池中待命，重复回收会让同一个Actor被交给两个调用方，此时输出警告
+	static bool IsIdlePooledActor(const AActor* Actor, const FTireflyPooledActorRecord* Record, const TCHAR* FunctionName);
+
+#pragma endregion
+
+
+#pragma region ActorPool_Active
+
+public:
+	/**
+	 * 遍历对象池中所有激活的Actor，即从对象池中取出且尚未回收的Actor，不需要在整个世界中查找Actor。
+	 * 遍历期间不要生成或回收该对象池的Actor，需要回收全部Actor时使用RecycleAllActiveActorsOfClass/Id
+	 *
+	 * @param ActorClass 对象池的目标类型
+	 * @param ActorId 对象池的目标Id，不为None时遍历Id池
+	 * @param Function 对每个激活的Actor调用的函数
+	 */
+	void ForEachActiveActorOfPool(TSubclassOf<AActor> ActorClass, FName ActorId, TFunctionRef<void(AActor*)> Function) const;
+
+	// 遍历句柄对应的对象池中所有激活的Actor，句柄失效时不做任何事
+	void ForEachActiveActor(const FTireflyActorPoolKey& PoolKey, TFunctionRef<void(AActor*)> Function) const;
+
+	// 获取对象池中所有激活的Actor
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	void GetActiveActorsOfPool(TSubclassOf<AActor> ActorClass, FName ActorId, TArray<AActor*>& OutActors) const;
+
+	// 获取对象池中激活的Actor数量
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	int32 GetActiveActorCountOfPool(TSubclassOf<AActor> ActorClass, FName ActorId) const;
+
+	// 把指定类型的Class池中所有激活的Actor回收到对象池，先对所有Actor执行PoolingEndPlay，再统一放回对象池
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (DisplayName = "Recycle All Active Actors (Class)"))
+	void RecycleAllActiveActorsOfClass(TSubclassOf<AActor> ActorClass);
+
+	// 把指定Id的Id池中所有激活的Actor回收到对象池，先对所有Actor执行PoolingEndPlay，再统一放回对象池
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (DisplayName = "Recycle All Active Actors (Id)"))
+	void RecycleAllActiveActorsOfId(FName ActorId);
+
+	// 把句柄对应的对象池中所有激活的Actor回收到对象池，句柄失效时不做任何事
+	void RecycleAllActiveActors(const FTireflyActorPoolKey& PoolKey);
+
+protected:
+	// 把Actor登记为对象池的激活Actor
+	void AddActiveActor(AActor* Actor, int32 PoolIndex, FTireflyPooledActorRecord& Record);
+
+	// 把Actor从所在对象池的激活Actor中移除，末尾的Actor填补它的位置
+	void RemoveActiveActor(AActor* Actor, FTireflyPooledActorRecord& Record);
+
+	void RecycleAllActiveActors_Internal(int32 PoolIndex);
+
+#pragma endregion
+
+
+#pragma region ActorPool_Proxy
+
+public:
+	// 获取对象池中以实例化静态网格体代理显示的Actor数量，这些Actor已经回收，不计入激活的Actor
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	int32 GetProxyCountOfPool(TSubclassOf<AActor> ActorClass, FName ActorId) const;
+
+protected:
+	// 按所有玩家的视点在激活Actor与代理之间切换
+	void TickActorPoolProxies();
+
+	// 在单个对象池中切换，每帧最多切换Policy.MaxProxySwapsPerFrame个：先把靠近的代理还原为Actor，再把远处的Actor替换为代理
+	void ProxyActorPool(int32 PoolIndex, TConstArrayView<FVector> ViewLocations);
+
+	// 回收激活的Actor，并在它的位置添加一个代理实例，Actor没有可用的网格体时返回false
+	bool DehydrateActor(int32 PoolIndex, AActor* Actor);
+
+	// 移除代理实例，并在它的位置从对象池中重新生成Actor，恢复剩余的存活时间、Owner、Instigator和初始化数据
+	void HydrateProxy(int32 PoolIndex, int32 ProxyIndex);
+
+	// 使用代理的对象池复制Actor的初始化数据，其他对象池直接返回
+	void RememberProxyInitialData(AActor* Actor, int32 PoolIndex, const FTireflyPoolingInitialDataRef& InitialData);
+
+	// 获取对象池的代理组件，尚未创建时以SourceActor的网格体创建
+	UInstancedStaticMeshComponent* FindOrCreateProxyComponent(int32 PoolIndex, const AActor* SourceActor);
+
+	// 销毁对象池的代理组件和所有代理
+	static void ClearActorPoolProxies(FTireflyActorPool& Pool);
+
+private:
+	// 承载所有代理组件的Actor
+	UPROPERTY()
+	AActor* ProxyHostActor = nullptr;
+
+#pragma endregion
+
+
+#pragma region ActorPool_Typed
+
+public:
+	/**
+	 * 提前为C++类型T分配类型槽位并绑定到T的Class池，之后的类型化生成与回收不再查找对象池。
+	 * 不调用时会在第一次类型化生成时自动绑定。
+	 */
+	template<typename T>
+	void RegisterTypedActorPool();
+
+	/**
+	 * 从C++类型T的对象池中生成Actor实例。
+	 * T必须在C++中实现ITireflyPoolingActorInterface（编译期检查），对象池通过类型槽位直接索引，
+	 * 返回值无需运行时类型转换。类型对象池就是T的Class池，与通过Actor类型生成、回收的Actor互通。
+	 *
+	 * @param Transform 要生成的Actor的初始化世界坐标系下的Transform
+	 * @param InitialData Actor实例的初始化数据，为空表示不初始化
+	 * @param Lifetime 生成的Actor的存活时间，默认为-1，表示一直存活
+	 * @param CollisionHandling 生成Actor时的初始碰撞处理方式，默认为AlwaysSpawn
+	 * @param Owner 要生成的Actor的Owner，默认为空
+	 * @param Instigator 要生成的Actor的Instigator，默认为空
+	 */
+	template<typename T>
+	T* SpawnTypedActorFromPool(
+		const FTransform& Transform,
+		const FInstancedStruct* InitialData = nullptr,
+		float Lifetime = -1.f,
+		const ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn,
+		AActor* Owner = nullptr,
+		APawn* Instigator = nullptr);
+
+	// 从C++类型T的对象池中生成Actor实例，并用C++类型化的初始化数据初始化，T必须实现TTireflyPoolingActorTypedInit<TInit>
+	template<typename T, typename TInit, typename = std::enable_if_t<TireflyActorPool::TIsTypedInitialData<TInit>>>
+	T* SpawnTypedActorFromPool(
+		const FTransform& Transform,
+		const TInit& InitialData,
+		float Lifetime = -1.f,
+		const ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn,
+		AActor* Owner = nullptr,
+		APawn* Instigator = nullptr);
+
+	/**
+	 * 把Actor回收到C++类型T的对象池中。
+	 * 只有精确类型为T、没有Id的Actor会通过类型槽位直接回收，其余情况（子类实例、Id池的Actor、其他线程上的调用）
+	 * 按RecycleActorToPool处理
+	 *
+	 * @param Actor 要回收的Actor
+	 */
+	template<typename T>
+	void RecycleTypedActorToPool(T* Actor);
+
+protected:
+	// 把类型槽位绑定到ActorClass的Class池，返回对象池的索引
+	int32 BindTypedActorPool(int32 TypeSlot, const TSubclassOf<AActor>& ActorClass);
+
+	// 获取C++类型T绑定的对象池索引，尚未绑定时立即绑定
+	template<typename T>
+	int32 FindOrBindTypedActorPool();
+
+	// 获取类型槽位绑定的对象池索引，尚未绑定时返回INDEX_NONE
+	int32 GetTypedActorPoolIndex(int32 TypeSlot) const
+	{
+		return TypedActorPoolIndices.IsValidIndex(TypeSlot) ? TypedActorPoolIndices[TypeSlot] : INDEX_NONE;
+	}
+
+	AActor* SpawnTypedActor_Internal(
+		int32 PoolIndex,
+		const TSubclassOf<AActor>& ActorClass,
+		const FTransform& Transform,
+		const FTireflyPoolingInitialDataRef& InitialData,
+		float Lifetime,
+		const ESpawnActorCollisionHandlingMethod CollisionHandling,
+		AActor* Owner,
+		APawn* Instigator);
+
+	void RecycleTypedActor_Internal(AActor* Actor, ITireflyPoolingActorInterface* PoolingInterface, int32 PoolIndex);
+
+private:
+	// 类型槽位对应的对象池在ActorPools中的索引，INDEX_NONE表示尚未绑定
+	TArray<int32> TypedActorPoolIndices;
+
+#pragma endregion
+
+
+#pragma region ActorPool_Object
+
+public:
+	/**
+	 * 从组件对象池中取出一个组件，把它移到Owner名下并注册，场景组件会挂接到AttachParent（为空时为Owner的根组件）上。
+	 * 注册时自动激活的组件会被重新激活，池中没有可用组件时会新创建
+	 *
+	 * @param ComponentClass 组件类型
+	 * @param Owner 组件的新Owner
+	 * @param RelativeTransform 场景组件相对挂接点的Transform，没有挂接点时为世界坐标系下的Transform
+	 * @param AttachParent 场景组件要挂接的组件，必须属于Owner，为空时挂接到Owner的根组件
+	 * @param SocketName 挂接的插槽
+	 * @param InitialData 组件的初始化数据，为空表示不初始化，只对实现了ITireflyPoolingObjectInterface的组件有效
+	 * @return 从对象池中取出的组件
+	 */
+	UActorComponent* SpawnComponentFromPool(
+		TSubclassOf<UActorComponent> ComponentClass,
+		AActor* Owner,
+		const FTransform& RelativeTransform = FTransform::Identity,
+		USceneComponent* AttachParent = nullptr,
+		FName SocketName = NAME_None,
+		const FInstancedStruct* InitialData = nullptr);
+
+	/**
+	 * 从UObject对象池中取出一个对象，池中没有可用对象时会新创建
+	 *
+	 * @param ObjectClass 对象类型，不能是Actor或组件
+	 * @param Outer 对象的Outer，为空时使用对象池子系统；与待命对象当前的Outer不同时会把对象移到新的Outer下
+	 * @param InitialData 对象的初始化数据，为空表示不初始化，只对实现了ITireflyPoolingObjectInterface的对象有效
+	 * @return 从对象池中取出的对象
+	 */
+	UObject* SpawnObjectFromPool(
+		TSubclassOf<UObject> ObjectClass,
+		UObject* Outer = nullptr,
+		const FInstancedStruct* InitialData = nullptr);
+
+	/**
+	 * 把组件或UObject回收到对应类型的对象池中。
+	 * 组件会被停用、解除挂接并注销，待命期间移到对象池的承载Actor名下，不再出现在原Owner的组件列表中，
+	 * 也不会随原Owner一起被销毁。
+	 * 对象池已满时组件会被直接销毁，UObject会被标记为垃圾
+	 *
+	 * @param Object 要回收的组件或UObject
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	void RecycleObjectToPool(UObject* Object);
+
+	// 预热组件或UObject对象池，创建指定数量的对象并使其在池中待命
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	void WarmUpObjectPool(TSubclassOf<UObject> ObjectClass, int32 Count = 16);
+
+	// 清理所有组件与UObject对象池
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	void ClearAllObjectPools();
+
+	// 清理指定类型的组件或UObject对象池
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	void ClearObjectPoolOfClass(TSubclassOf<UObject> ObjectClass);
+
+	// 设置指定类型的组件或UObject对象池的容量与裁剪策略，如果对象池中的待命对象超出新的容量上限，超出的部分会被立即销毁
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	void SetObjectPoolPolicyOfClass(TSubclassOf<UObject> ObjectClass, const FTireflyActorPoolPolicy& Policy);
+
+	// 获取指定类型的组件或UObject对象池的容量与裁剪策略，如果对象池不存在则返回默认策略
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	FTireflyActorPoolPolicy GetObjectPoolPolicyOfClass(TSubclassOf<UObject> ObjectClass) const;
+
+protected:
+	// 校验对象类型是否可以使用组件或UObject对象池
+	static bool IsValidObjectPoolClass(const UClass* ObjectClass, const TCHAR* FunctionName);
+
+	// 从对象池中取出一个待命对象，跳过已经失效的对象，并记录一次请求
+	UObject* FetchObjectFromPool(FTireflyObjectPool& Pool);
+
+	// 创建一个新的对象，创建的对象使用对象池的Outer，由调用方移到最终的Outer下
+	UObject* CreatePooledObject_Internal(const TSubclassOf<UObject>& ObjectClass);
+
+	// 销毁对象池中超出容量上限的待命对象，优先销毁闲置最久的对象
+	void EnforceObjectPoolCapacity(FTireflyObjectPool& Pool);
+
+	// 裁剪单个对象池中闲置超时的待命对象
+	void TrimObjectPool(FTireflyObjectPool& Pool, double CurrentTime);
+
+	// 销毁待命对象，组件会被DestroyComponent，普通UObject会被标记为垃圾
+	static void DestroyIdleObject(UObject* Object);
+
+	// 获取承载待命组件的Actor，尚未生成时生成一个临时的Actor；世界正在销毁时返回空
+	AActor* FindOrCreateIdleComponentHost();
+
+private:
+	// 承载所有待命组件的Actor
+	UPROPERTY()
+	AActor* IdleComponentHostActor = nullptr;
+
+#pragma endregion
+
+
+#pragma region ActorPool_Lifetime
+
+public:
+	/**
+	 * 设置（或刷新）对象池Actor的存活时间，从当前时刻开始重新计时，到期后Actor会被自动回收到对象池中
+	 *
+	 * @param Actor 目标Actor
+	 * @param Lifetime 新的存活时间，小于等于0表示取消自动回收
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	void SetActorLifetime(AActor* Actor, float Lifetime);
+
+	/**
+	 * 延长对象池Actor的剩余存活时间，只对已设置存活时间的Actor有效
+	 *
+	 * @param Actor 目标Actor
+	 * @param ExtraTime 延长的时间，可以为负数以缩短存活时间
+	 * @return Actor是否已设置存活时间
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	bool ExtendActorLifetime(AActor* Actor, float ExtraTime);
+
+	// 取消对象池Actor的自动回收
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	void ClearActorLifetime(AActor* Actor);
+
+	// 获取对象池Actor的剩余存活时间，如果Actor没有设置存活时间则返回-1
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	float GetActorRemainingLifetime(AActor* Actor) const;
+
+protected:
+	// 推进生命周期时间轮，把到期的Actor批量回收到对象池中
+	void TickActorLifetimes();
+
+private:
+	// 对象池Actor生命周期的时间轮
+	FTireflyActorLifetimeWheel LifetimeWheel;
+
+	// 每帧到期Actor的临时缓存，避免反复分配
+	TArray<AActor*> ExpiredActors;
+
+#pragma endregion
+
+
+#pragma region ActorPool_WarmUp
+
+public:
+	/**
+	 * 预热特定类型（或特定Id）的对象池，生成指定数量的Actor并使其在池中待命
+	 * 
+	 * @param ActorClass 对象池的目标类型
+	 * @param ActorId 对象池的目标Id
+	 * @param Count 预热的Actor数量
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	void WarmUpActorPool(
+		TSubclassOf<AActor> ActorClass,
+		FName ActorId,
+		int32 Count = 16);
+
+	// 预热句柄对应的对象池，句柄失效时不做任何事
+	void WarmUpActorPool(const FTireflyActorPoolKey& PoolKey, int32 Count = 16);
+
+	/**
+	 * 把预热任务加入分帧预热队列，每帧在预算时间内逐步生成Actor，避免在一帧内集中生成大量Actor造成卡顿
+	 *
+	 * @param ActorClass 对象池的目标类型
+	 * @param ActorId 对象池的目标Id
+	 * @param Count 预热的Actor数量
+	 * @param Priority 任务优先级，数值越大越先执行，相同优先级的任务按加入顺序执行
+	 * @param OnCompleted 任务完成时的回调
+	 * @return 预热任务的句柄，无效时返回INDEX_NONE
+	 */
+	int32 QueueWarmUpActorPool(
+		TSubclassOf<AActor> ActorClass,
+		FName ActorId,
+		int32 Count = 16,
+		int32 Priority = 0,
+		FSimpleDelegate OnCompleted = FSimpleDelegate());
+
+	// 把句柄对应的对象池的预热任务加入分帧预热队列，句柄失效时返回INDEX_NONE
+	int32 QueueWarmUpActorPool(
+		const FTireflyActorPoolKey& PoolKey,
+		int32 Count = 16,
+		int32 Priority = 0,
+		FSimpleDelegate OnCompleted = FSimpleDelegate());
+
+	/**
+	 * 把预热任务加入分帧预热队列，每帧在预算时间内逐步生成Actor，避免在一帧内集中生成大量Actor造成卡顿
+	 *
+	 * @param ActorClass 对象池的目标类型
+	 * @param ActorId 对象池的目标Id
+	 * @param Count 预热的Actor数量
+	 * @param Priority 任务优先级，数值越大越先执行，相同优先级的任务按加入顺序执行
+	 * @param OnCompleted 任务完成时的回调
+	 * @return 预热任务的句柄，无效时返回-1
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (DisplayName = "Queue Warm Up Actor Pool", AutoCreateRefTerm = "OnCompleted"))
+	int32 K2_QueueWarmUpActorPool(
+		TSubclassOf<AActor> ActorClass,
+		FName ActorId,
+		const FTireflyActorPoolWarmUpCompletedDelegate& OnCompleted,
+		int32 Count = 16,
+		int32 Priority = 0);
+
+	// 取消分帧预热任务，已经生成的Actor会留在对象池中，且不会触发完成回调
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	void CancelWarmUp(int32 WarmUpHandle);
+
+	// 获取分帧预热任务的进度（0~1），已完成或已取消的任务返回1，无效的句柄返回-1
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	float GetWarmUpProgress(int32 WarmUpHandle) const;
+
+	// 分帧预热任务是否仍在队列中
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	bool IsWarmUpInProgress(int32 WarmUpHandle) const;
+
+	// 获取分帧预热队列中尚未生成的Actor总数
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	int32 GetPendingWarmUpActorCount() const;
+
+	// 设置分帧预热每帧可以使用的时间预算（毫秒），每帧至少会生成一个Actor以保证进度
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	void SetWarmUpFrameBudget(float BudgetMs);
 
-#pragma region WorldSubsystem
+	// 获取分帧预热每帧可以使用的时间预算（毫秒）
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	float GetWarmUpFrameBudget() const { return WarmUpFrameBudgetMs; }
 
-public:
-	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+protected:
+	// 生成一个在对象池中待命的Actor，但不放入对象池
+	AActor* SpawnWarmUpActor_Internal(UWorld* World, const TSubclassOf<AActor>& ActorClass, FName ActorId);
 
-	virtual void Deinitialize() override;
+	// 在时间预算内推进分帧预热队列
+	void TickWarmUpQueue();
 
 private:
-	// 对象池操作的线程安全锁
-	FCriticalSection PoolLock;
+	// 按优先级从高到低排列的分帧预热任务
+	TArray<FTireflyActorPoolWarmUpJob> WarmUpQueue;
 
+	// 分帧预热每帧可以使用的时间预算（毫秒）
+	float WarmUpFrameBudgetMs = 2.f;
+
+	// 下一个分帧预热任务的句柄
+	int32 NextWarmUpHandle = 1;
+	
 #pragma endregion
 
 
-#pragma region ActorPool_Clear
+#pragma region ActorPool_Deferred
 
 public:
-	// 清理所有Actor池
+	/**
+	 * 从Actor对象池中生成Actor实例，对象池中有待命Actor或本帧即时生成预算未用完时立即生成，
+	 * 否则把请求加入按优先级排列的延迟生成队列，在之后几帧的预算内完成
+	 *
+	 * @param ActorClass 要生成的Actor类型
+	 * @param ActorId 要生成的Actor的Id标识
+	 * @param Transform 要生成的Actor的初始化世界坐标系下的Transform
+	 * @param InitialData Actor实例的初始化数据，无效的InstancedStruct表示不初始化
+	 * @param Lifetime 生成的Actor的存活时间，小于等于0表示一直存活
+	 * @param CollisionHandling 生成Actor时的初始碰撞处理方式
+	 * @param Owner 要生成的Actor的Owner
+	 * @param Instigator 要生成的Actor的Instigator
+	 * @param Priority 请求优先级，数值越大越先执行，相同优先级的请求按提交顺序执行
+	 * @param bDroppable 是否可以在负载过高时放弃，等待超过DeferredSpawnDropTimeout的请求会被放弃，适用于纯表现用的Actor
+	 * @param OnSpawned 生成完成后的回调，生成失败或请求被放弃时参数为空
+	 * @return 延迟生成请求的句柄，请求被立即处理或无效时返回INDEX_NONE
+	 */
+	int32 SpawnActorFromPoolDeferred(
+		TSubclassOf<AActor> ActorClass,
+		FName ActorId,
+		const FTransform& Transform,
+		const FInstancedStruct& InitialData,
+		float Lifetime,
+		const ESpawnActorCollisionHandlingMethod CollisionHandling,
+		AActor* Owner,
+		APawn* Instigator,
+		int32 Priority,
+		bool bDroppable,
+		TFunction<void(AActor*)>&& OnSpawned);
+
+	// 取消延迟生成请求，被取消的请求不会触发回调
 	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
-	void ClearAllActorPools();
+	void CancelDeferredSpawn(int32 DeferredSpawnHandle);
 
-	// 清理指定类型的Actor池
-	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (DisplayName = "Clear Actor Pools (Class)"))
-	void ClearActorPoolsOfClass(TSubclassOf<AActor> ActorClass);
+	// 延迟生成请求是否仍在队列中
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	bool IsDeferredSpawnPending(int32 DeferredSpawnHandle) const;
 
-	// 清理指定Id的Actor池
-	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool", Meta = (DisplayName = "Clear Actor Pools (Id)"))
-	void ClearActorPoolOfId(FName ActorId);
+	// 获取延迟生成队列中的请求数量
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	int32 GetPendingDeferredSpawnCount() const { return DeferredSpawnQueue.Num(); }
 
-#pragma endregion
+	/**
+	 * 设置每帧即时生成新Actor的预算，超出预算的延迟生成请求会排队到之后几帧，直接调用SpawnActorFromPool的即时生成也会占用预算
+	 *
+	 * @param BudgetCount 每帧最多即时生成的Actor数量，小于等于0表示不限制
+	 * @param BudgetMs 每帧即时生成可以使用的时间（毫秒），小于等于0表示不限制
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	void SetColdSpawnFrameBudget(int32 BudgetCount, float BudgetMs);
 
+	// 获取每帧最多即时生成的Actor数量
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	int32 GetColdSpawnFrameBudgetCount() const { return ColdSpawnFrameBudgetCount; }
 
-#pragma region ActorPool_Spawn
+	// 获取每帧即时生成可以使用的时间（毫秒）
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	float GetColdSpawnFrameBudgetMs() const { return ColdSpawnFrameBudgetMs; }
 
 protected:
-	AActor* FetchActorFromPool(const TSubclassOf<AActor>& ActorClass, FName ActorId);
-	
-	AActor* SpawnActor_Internal(
-		const TSubclassOf<AActor>& ActorClass,
-		FName ActorId,
-		const FTransform& Transform,
-		const FInstancedStruct* InitialData = nullptr,
-		float Lifetime = -1.f,
-		const ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn,
-		AActor* Owner = nullptr,
-		APawn* Instigator = nullptr);
+	// 本帧的即时生成预算是否还有剩余
+	bool HasColdSpawnBudget() const;
+
+	// 在预算内推进延迟生成队列，并放弃等待超时的可放弃请求
+	void TickDeferredSpawnQueue();
+
+private:
+	// 按优先级从高到低排列的延迟生成请求
+	TArray<FTireflyActorPoolDeferredSpawn> DeferredSpawnQueue;
+
+	// 每帧最多即时生成的Actor数量，小于等于0表示不限制
+	int32 ColdSpawnFrameBudgetCount = 0;
+
+	// 每帧即时生成可以使用的时间（毫秒），小于等于0表示不限制
+	float ColdSpawnFrameBudgetMs = 0.f;
+
+	// 可放弃的延迟生成请求最多等待的时间（秒）
+	float DeferredSpawnDropTimeout = 0.5f;
+
+	// 本帧已经即时生成的Actor数量
+	int32 ColdSpawnsThisFrame = 0;
+
+	// 本帧即时生成已经使用的时间（秒）
+	double ColdSpawnSecondsThisFrame = 0.0;
+
+	// 下一个延迟生成请求的句柄
+	int32 NextDeferredSpawnHandle = 1;
+
+#pragma endregion
+
+
+#pragma region ActorPool_Async
 
 public:
-	template<typename T>
-	T* SpawnActorFromPool(
-		TSubclassOf<T> ActorClass,
+	/**
+	 * 通过StreamableManager异步加载软引用的Actor类型及其依赖资源，加载完成后回调，
+	 * 已加载的Actor类型会立即回调，加载过的Actor类型在子系统的生命周期内保持常驻
+	 *
+	 * @param ActorClass 要加载的Actor类型
+	 * @param OnLoaded 加载完成后的回调，加载失败时参数为空
+	 */
+	void LoadActorClassAsync(const TSoftClassPtr<AActor>& ActorClass, TFunction<void(UClass*)>&& OnLoaded);
+
+	/**
+	 * 异步加载软引用的Actor类型，加载完成后把预热任务加入分帧预热队列
+	 *
+	 * @param ActorClass 对象池的目标类型
+	 * @param ActorId 对象池的目标Id
+	 * @param Count 预热的Actor数量
+	 * @param Priority 预热任务的优先级，数值越大越先执行
+	 * @param OnCompleted 预热完成后的回调，加载失败时参数为false
+	 */
+	void WarmUpActorPoolAsync(
+		const TSoftClassPtr<AActor>& ActorClass,
+		FName ActorId,
+		int32 Count = 16,
+		int32 Priority = 0,
+		TFunction<void(bool)>&& OnCompleted = nullptr);
+
+	/**
+	 * 异步加载软引用的Actor类型，加载完成后从对象池中生成Actor实例
+	 *
+	 * @param ActorClass 要生成的Actor类型
+	 * @param ActorId 要生成的Actor的Id标识
+	 * @param Transform 要生成的Actor的初始化世界坐标系下的Transform
+	 * @param InitialData Actor实例的初始化数据，无效的InstancedStruct表示不初始化
+	 * @param Lifetime 生成的Actor的存活时间，默认为-1，表示一直存活
+	 * @param CollisionHandling 生成Actor时的初始碰撞处理方式，默认为AlwaysSpawn
+	 * @param Owner 要生成的Actor的Owner，默认为空
+	 * @param Instigator 要生成的Actor的Instigator，默认为空
+	 * @param OnSpawned 生成完成后的回调，加载或生成失败时参数为空
+	 */
+	void SpawnActorFromPoolAsync(
+		const TSoftClassPtr<AActor>& ActorClass,
 		FName ActorId,
 		const FTransform& Transform,
-		const FInstancedStruct* InitialData = nullptr,
-		float Lifetime = -1.f,
-		const ESpawnActorCollisionHandlingMethod CollisionHandling = ESpawnActorCollisionHandlingMethod::AlwaysSpawn,
-		AActor* Owner = nullptr,
-		APawn* Instigator = nullptr);
+		const FInstancedStruct& InitialData,
+		float Lifetime,
+		const ESpawnActorCollisionHandlingMethod CollisionHandling,
+		AActor* Owner,
+		APawn* Instigator,
+		TFunction<void(AActor*)>&& OnSpawned);
+
+private:
+	// 对象池使用的资源加载管理器
+	FStreamableManager StreamableManager;
+
+	// 异步加载过的Actor类型的加载句柄，用于让Actor类型及其依赖资源保持常驻
+	TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> ActorClassLoadHandles;
 
 #pragma endregion
 
 
-#pragma region ActorPool_Recycle
+#pragma region ActorPool_Reservation
 
 public:
 	/**
-	 * 把Actor回收到Actor池里，如果Actor有Id，
-	 * 并且Actor实现了 ITireflyPoolingActorInterface::GetActorId，
-	 * 则回到对应Id的Actor池，
-	 * 否则回到Actor类的Actor池
-	 * 
-	 * @param Actor 要回收的Actor
+	 * 按对象池配置为指定内容（流送关卡、数据层或任意对象）保留对象池：配置中的预热数量即保留数量，
+	 * 对象池会预热到保留的数量，且闲置裁剪不会低于该数量；同一内容重复保留会先释放之前的保留
+	 *
+	 * @param ReservationOwner 保留的所属内容，释放时使用同一个对象
+	 * @param Config 对象池配置资产，策略覆盖会一并应用
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
-	void RecycleActorToPool(AActor* Actor);
+	void ReserveActorPools(const UObject* ReservationOwner, const UTireflyActorPoolConfig* Config);
+
+	// 按一组对象池配置为指定内容保留对象池
+	void ReserveActorPoolEntries(const UObject* ReservationOwner, TConstArrayView<FTireflyActorPoolConfigEntry> Entries);
+
+	// 释放指定内容的所有保留，保留的待命Actor会在之后几帧内逐步销毁，仍在使用中的Actor回收后再销毁
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	void ReleaseActorPoolReservations(const UObject* ReservationOwner);
+
+	// 释放指定内容的所有保留，所属内容已被销毁时也可以使用
+	void ReleaseActorPoolReservations(FObjectKey ReservationOwner);
+
+	// 指定内容是否持有对象池保留
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	bool HasActorPoolReservations(const UObject* ReservationOwner) const;
+
+protected:
+	// 保留的Actor类型加载完成后计入对象池，并预热对象池中还缺少的部分
+	void ApplyActorPoolReservation(FObjectKey ReservationOwner, int32 ReservationId, UClass* LoadedClass);
+
+	// 按项目设置，为开始流送的关卡保留对象池，为不再需要加载的关卡释放保留
+	void TickStreamingLevelReservations();
+
+	// 按项目设置，为当前已加载的数据层保留对象池，并监听数据层的运行时状态变化
+	void BindDataLayerReservations(UWorld& InWorld);
+
+	// 异步加载项目设置中流送关卡和数据层的对象池配置并保持常驻，保留时不再同步加载配置
+	void LoadReservationConfigs();
+
+	// 对象池配置加载完成后，为加载期间已经开始加载的数据层补上保留，流送关卡在之后的Tick中处理
+	void HandleReservationConfigsLoaded();
+
+	UFUNCTION()
+	void HandleDataLayerRuntimeStateChanged(const UDataLayerInstance* DataLayer, EDataLayerRuntimeState State);
+
+private:
+	// 各个内容持有的对象池保留
+	TMap<FObjectKey, TArray<FTireflyActorPoolReservation>> ActorPoolReservations;
+
+	// 项目设置中配置了对象池的流送关卡，以关卡包名为键
+	TMap<FName, TSoftObjectPtr<UTireflyActorPoolConfig>> StreamingLevelPoolConfigs;
+
+	// 已经按项目设置保留了对象池的流送关卡
+	TArray<FObjectKey> ReservedStreamingLevels;
+
+	// 流送关卡和数据层的对象池配置的加载句柄，配置在世界运行期间保持常驻
+	TSharedPtr<FStreamableHandle> ReservationConfigsHandle;
+
+	// 下一个保留的唯一标识
+	int32 NextReservationId = 1;
 
 #pragma endregion
 
 
-#pragma region ActorPool_WarmUp
+#pragma region ActorPool_Config
 
 public:
 	/**
-	 * 预热特定类型（或特定Id）的对象池，生成指定数量的Actor并使其在池中待命
-	 * 
-	 * @param ActorClass 对象池的目标类型
-	 * @param ActorId 对象池的目标Id
-	 * @param Count 预热的Actor数量
+	 * 应用对象池配置资产：覆盖配置中指定的对象池策略，并通过异步加载和分帧预热队列预热对象池
+	 *
+	 * @param Config 对象池配置资产
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
-	void WarmUpActorPool(
-		TSubclassOf<AActor> ActorClass,
-		FName ActorId,
-		int32 Count = 16);
-	
+	void ApplyActorPoolConfig(const UTireflyActorPoolConfig* Config);
+
+	// 应用一组对象池配置
+	void ApplyActorPoolConfigEntries(TConstArrayView<FTireflyActorPoolConfigEntry> Entries);
+
+protected:
+	// 按项目设置收集当前世界需要应用的对象池配置，按应用顺序排列：默认配置、地图配置、游戏模式配置，后面的配置覆盖前面的配置
+	void GatherActorPoolConfigs(const UWorld& InWorld, TArray<TSoftObjectPtr<UTireflyActorPoolConfig>>& OutConfigs) const;
+
+	// 异步加载世界开始运行时需要应用的对象池配置，加载完成后再应用配置和使用情况清单
+	void LoadWorldPoolConfigs(const UWorld& InWorld);
+
+	// 世界开始运行时的对象池配置加载完成后，合并并应用配置中的条目，之后按项目设置应用使用情况清单
+	void HandleWorldPoolConfigsLoaded();
+
+	// 把开启了bPersistAcrossTravel的对象池交给游戏实例保存，在世界销毁、对象池被清理之前调用
+	void StashPersistentActorPools();
+
+	// 取回游戏实例保存的持久对象池，恢复策略并重新预热；无缝切换地图的过渡地图不取回，留给目标地图
+	void RestorePersistentActorPools();
+
+	// 世界是否为无缝切换地图时使用的过渡地图
+	static bool IsTransitionWorld(const UWorld& InWorld);
+
+private:
+	// 世界开始运行时需要应用的对象池配置，按应用顺序排列，加载完成并应用后清空
+	TArray<TSoftObjectPtr<UTireflyActorPoolConfig>> WorldPoolConfigs;
+
+	// 世界开始运行时的对象池配置的加载句柄
+	TSharedPtr<FStreamableHandle> WorldPoolConfigsHandle;
+
+#pragma endregion
+
+
+#pragma region ActorPool_Manifest
+
+public:
+	/**
+	 * 把本次运行中各个对象池的使用情况（峰值、未命中次数、首次请求时间）写入当前地图的使用情况清单，
+	 * 与已有的清单合并时峰值取较大值
+	 *
+	 * @return 是否写入成功
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	bool SaveActorPoolUsageManifest();
+
+protected:
+	// 读取当前地图的使用情况清单，按首次请求的先后顺序把对象池预热到记录的峰值
+	void ApplyActorPoolUsageManifest(const UWorld& InWorld);
+
+	// 获取分帧预热队列中指定对象池尚未生成的Actor数量
+	int32 GetPendingWarmUpActorCountOfPool(const UClass* ActorClass, FName ActorId) const;
+
+	// 获取世界对应的地图包名，PIE中的地图包名会去掉前缀
+	static FString GetMapPackageName(const UWorld& InWorld);
+
+private:
+	// 本次运行是否需要在结束时写入使用情况清单
+	bool bRecordingUsageManifest = false;
+
 #pragma endregion
 
 
@@ -145,20 +1803,85 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
 	int32 Debug_GetActorNumberOfIdPool(FName ActorId) const;
 
+	// 获取特定类型的对象池的运行统计，如果不存在指定类型的对象池则返回空统计
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	FTireflyActorPoolStats Debug_GetActorPoolStatsOfClass(TSubclassOf<AActor> ActorClass) const;
+
+	// 获取特定Id的对象池的运行统计，如果不存在指定Id的对象池则返回空统计
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	FTireflyActorPoolStats Debug_GetActorPoolStatsOfId(FName ActorId) const;
+
+	// 获取在组件与UObject对象池中所有的对象类型
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	TArray<TSubclassOf<UObject>> Debug_GetAllObjectPoolClasses() const;
+
+	// 获取特定类型的组件或UObject对象池中剩余对象的数量，如果不存在指定类型的对象池，则返回-1
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	int32 Debug_GetObjectNumberOfClassPool(TSubclassOf<UObject> ObjectClass) const;
+
+	// 获取特定类型的组件或UObject对象池的运行统计，如果不存在指定类型的对象池则返回空统计
+	UFUNCTION(BlueprintPure, Category = "Tirefly Actor Pool")
+	FTireflyActorPoolStats Debug_GetObjectPoolStatsOfClass(TSubclassOf<UObject> ObjectClass) const;
+
+	// 以表格形式输出所有对象池的运行统计，对应控制台命令TireflyActorPool.Dump
+	void DumpActorPoolStats(FOutputDevice& Ar) const;
+
+	// 清零所有对象池的命中、未命中、即时生成和回收统计，峰值重置为当前的激活数量
+	UFUNCTION(BlueprintCallable, Category = "Tirefly Actor Pool")
+	void ResetActorPoolStats();
+
+protected:
+	// 把对象池的内部计数转换为运行统计
+	static FTireflyActorPoolStats MakeActorPoolStats(const FTireflyActorPool& Pool);
+	static FTireflyActorPoolStats MakeActorPoolStats(const FTireflyObjectPool& Pool);
+
+	// 每帧更新待命与激活Actor总数的统计
+	void TickActorPoolStats();
+
+#pragma endregion
+
+
+#pragma region ActorPool_Record
+
+public:
+	// 获取对象池Actor的记录中保存组件列表的位置，Actor没有记录时返回空
+	TSharedPtr<FTireflyPooledActorComponents, ESPMode::NotThreadSafe>* FindPooledActorComponents(const AActor* Actor);
+
+protected:
+	// 为对象池新生成的Actor创建记录，记录会在Actor被销毁时清除
+	FTireflyPooledActorRecord& AddPooledActorRecord(AActor* Actor, int32 PoolIndex);
+
+private:
+	// 由对象池生成的Actor被销毁时清除它的记录
+	UFUNCTION()
+	void HandlePooledActorDestroyed(AActor* DestroyedActor);
+
+	// 由对象池生成的Actor的记录
+	TMap<TObjectKey<AActor>, FTireflyPooledActorRecord> PooledActorRecords;
+
 #pragma endregion
 
 
 #pragma region ActorPool_Declaration
 
 private:
+	// 所有的Class池和Id池，通过下面的索引表查找，被清理的对象池的位置会被之后创建的对象池复用
 	UPROPERTY()
-	TMap<TSubclassOf<AActor>, FTireflyActorPool> ActorPoolOfClass;
+	TArray<FTireflyActorPool> ActorPools;
 
+	// Actor类型对应的Class池在ActorPools中的索引
 	UPROPERTY()
-	TMap<FName, FTireflyActorPool> ActorPoolOfId;
+	TMap<TSubclassOf<AActor>, int32> ActorPoolIndexOfClass;
+
+	// ActorId对应的Id池在ActorPools中的索引
+	TMap<FName, int32> ActorPoolIndexOfId;
+
+	// ActorPools中已被清理、可以复用的位置
+	TArray<int32> FreeActorPoolIndices;
 
+	// 组件与UObject对象池
 	UPROPERTY()
-	TMap<AActor*, FTimerHandle> ActorLifetimeTimers;
+	TMap<TSubclassOf<UObject>, FTireflyObjectPool> ObjectPoolOfClass;
 
 #pragma endregion
 };
@@ -167,9 +1890,87 @@ private:
 #pragma region ActorPool_FunctionTemplate
 
 template<typename T>
+T* UTireflyActorPoolWorldSubsystem::CastSpawnedActor(AActor* Actor)
+{
+	T* TypedActor = Cast<T>(Actor);
+	if (Actor && !TypedActor)
+	{
+		RecycleMismatchedActor(Actor, T::StaticClass());
+	}
+
+	return TypedActor;
+}
+
+template<typename T>
+T* UTireflyActorPoolWorldSubsystem::SpawnActorFromPool(
+	TSubclassOf<T> ActorClass,
+	FName ActorId,
+	const FTransform& Transform,
+	const FInstancedStruct* InitialData,
+	float Lifetime,
+	const ESpawnActorCollisionHandlingMethod CollisionHandling,
+	AActor* Owner,
+	APawn* Instigator)
+{
+	return CastSpawnedActor<T>(SpawnActor_Internal(ActorClass, ActorId, Transform, InitialData, Lifetime, CollisionHandling, Owner, Instigator));
+}
+
+template<typename T>
+T* UTireflyActorPoolWorldSubsystem::SpawnActorFromPool(
+	const FTireflyActorPoolKey& PoolKey,
+	const FTransform& Transform,
+	const FInstancedStruct* InitialData,
+	float Lifetime,
+	const ESpawnActorCollisionHandlingMethod CollisionHandling,
+	AActor* Owner,
+	APawn* Instigator)
+{
+	return CastSpawnedActor<T>(SpawnActorFromPoolKey_Internal(PoolKey, Transform, InitialData, Lifetime, CollisionHandling, Owner, Instigator));
+}
+
+template<typename T, typename TInit, typename>
 T* UTireflyActorPoolWorldSubsystem::SpawnActorFromPool(
 	TSubclassOf<T> ActorClass,
 	FName ActorId,
+	const FTransform& Transform,
+	const TInit& InitialData,
+	float Lifetime,
+	const ESpawnActorCollisionHandlingMethod CollisionHandling,
+	AActor* Owner,
+	APawn* Instigator)
+{
+	return CastSpawnedActor<T>(SpawnActor_Internal(ActorClass, ActorId, Transform, FTireflyPoolingInitialDataRef::MakeTyped<T>(InitialData), Lifetime, CollisionHandling, Owner, Instigator));
+}
+
+template<typename T, typename TInit, typename>
+T* UTireflyActorPoolWorldSubsystem::SpawnActorFromPool(
+	const FTireflyActorPoolKey& PoolKey,
+	const FTransform& Transform,
+	const TInit& InitialData,
+	float Lifetime,
+	const ESpawnActorCollisionHandlingMethod CollisionHandling,
+	AActor* Owner,
+	APawn* Instigator)
+{
+	return CastSpawnedActor<T>(SpawnActorFromPoolKey_Internal(PoolKey, Transform, FTireflyPoolingInitialDataRef::MakeTyped<T>(InitialData), Lifetime, CollisionHandling, Owner, Instigator));
+}
+
+template<typename T>
+int32 UTireflyActorPoolWorldSubsystem::FindOrBindTypedActorPool()
+{
+	const int32 TypeSlot = TTireflyActorPoolTypeSlot<T>::Get();
+	const int32 PoolIndex = GetTypedActorPoolIndex(TypeSlot);
+	return PoolIndex != INDEX_NONE ? PoolIndex : BindTypedActorPool(TypeSlot, T::StaticClass());
+}
+
+template<typename T>
+void UTireflyActorPoolWorldSubsystem::RegisterTypedActorPool()
+{
+	FindOrBindTypedActorPool<T>();
+}
+
+template<typename T>
+T* UTireflyActorPoolWorldSubsystem::SpawnTypedActorFromPool(
 	const FTransform& Transform,
 	const FInstancedStruct* InitialData,
 	float Lifetime,
@@ -177,7 +1978,75 @@ T* UTireflyActorPoolWorldSubsystem::SpawnActorFromPool(
 	AActor* Owner,
 	APawn* Instigator)
 {
-	return Cast<T>(SpawnActor_Internal(ActorClass, ActorId, Transform, InitialData, Lifetime, CollisionHandling, Owner, Instigator));
+	const int32 PoolIndex = FindOrBindTypedActorPool<T>();
+	AActor* Actor = SpawnTypedActor_Internal(PoolIndex, T::StaticClass(), Transform, InitialData, Lifetime, CollisionHandling, Owner, Instigator);
+
+	// 类型化对象池只会生成T::StaticClass()的实例，不需要再做运行时类型转换
+	checkSlow(!Actor || Actor->GetClass() == T::StaticClass());
+	return static_cast<T*>(Actor);
+}
+
+template<typename T, typename TInit, typename>
+T* UTireflyActorPoolWorldSubsystem::SpawnTypedActorFromPool(
+	const FTransform& Transform,
+	const TInit& InitialData,
+	float Lifetime,
+	const ESpawnActorCollisionHandlingMethod CollisionHandling,
+	AActor* Owner,
+	APawn* Instigator)
+{
+	const int32 PoolIndex = FindOrBindTypedActorPool<T>();
+	AActor* Actor = SpawnTypedActor_Internal(PoolIndex, T::StaticClass(), Transform, FTireflyPoolingInitialDataRef::MakeTyped<T>(InitialData), Lifetime, CollisionHandling, Owner, Instigator);
+
+	// 类型化对象池只会生成T::StaticClass()的实例，不需要再做运行时类型转换
+	checkSlow(!Actor || Actor->GetClass() == T::StaticClass());
+	return static_cast<T*>(Actor);
+}
+
+template<typename T>
+void UTireflyActorPoolWorldSubsystem::RecycleTypedActorToPool(T* Actor)
+{
+	const int32 PoolIndex = GetTypedActorPoolIndex(TTireflyActorPoolTypeSlot<T>::Get());
+	if (PoolIndex == INDEX_NONE || !IsValid(Actor) || Actor->GetClass() != T::StaticClass())
+	{
+		RecycleActorToPool(Actor);
+		return;
+	}
+
+	RecycleTypedActor_Internal(Actor, Actor, PoolIndex);
+}
+
+template<typename T>
+void UTireflyActorPoolWorldSubsystem::SpawnActorsFromPool(
+	TSubclassOf<T> ActorClass,
+	FName ActorId,
+	TConstArrayView<FTransform> Transforms,
+	TArray<T*>& OutActors,
+	TConstArrayView<FInstancedStruct> InitialData,
+	float Lifetime,
+	const ESpawnActorCollisionHandlingMethod CollisionHandling,
+	AActor* Owner,
+	APawn* Instigator)
+{
+	if constexpr (std::is_same_v<T, AActor>)
+	{
+		SpawnActors_Internal(ActorClass, ActorId, Transforms, OutActors, InitialData, Lifetime, CollisionHandling, Owner, Instigator);
+	}
+	else
+	{
+		// Id池中可能混有不同类型的Actor，逐个检查类型
+		TArray<AActor*> SpawnedActors;
+		SpawnActors_Internal(ActorClass, ActorId, Transforms, SpawnedActors, InitialData, Lifetime, CollisionHandling, Owner, Instigator);
+
+		OutActors.Reserve(OutActors.Num() + SpawnedActors.Num());
+		for (AActor* Actor : SpawnedActors)
+		{
+			if (T* TypedActor = CastSpawnedActor<T>(Actor))
+			{
+				OutActors.Add(TypedActor);
+			}
+		}
+	}
 }
 
 #pragma endregion
\ No newline at end of file
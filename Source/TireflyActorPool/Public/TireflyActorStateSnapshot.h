@@ -0,0 +1,71 @@
+// Copyright Tirefly. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+
+// 一个Actor类型中需要在回收时重置的属性列表，按类型缓存
+struct FTireflyActorResetLayout
+{
+	// 按值快照的属性及其在快照缓冲区中的偏移
+	TArray<const FProperty*> ValueProperties;
+	TArray<int32> ValueOffsets;
+
+	// 强引用的对象属性，快照中以弱引用保存，避免快照延长对象的生命周期或在对象被回收后留下悬空指针
+	TArray<const FObjectPropertyBase*> ObjectProperties;
+
+	// 快照缓冲区的大小与对齐
+	int32 BufferSize = 0;
+	int32 BufferAlignment = 1;
+
+	/**
+	 * 获取Actor类型的重置属性列表，第一次使用时构建并缓存
+	 *
+	 * 只包含在实现了ITireflyPoolingActorInterface的类（即项目自己的Actor类，包括蓝图类）中声明的属性，
+	 * 不包含引擎基类的属性；委托、静态数组以及包含强引用的容器和结构体不会被重置，需要在PoolingEndPlay中手动处理。
+	 */
+	static TSharedRef<const FTireflyActorResetLayout> Get(const UClass* ActorClass);
+
+	/**
+	 * 注册缓存的清理：蓝图类被重新编译、热重载完成或游戏世界被清理（包括PIE结束）时清空缓存，
+	 * 同时清空FTireflyPoolingActorDispatch和FTireflyPoolingObjectDispatch的调用记录，
+	 * 避免继续使用已经失效的FProperty和UFunction。由模块启动时调用
+	 */
+	static void RegisterCacheInvalidation();
+
+	// 注销缓存的清理并清空缓存，由模块关闭时调用
+	static void UnregisterCacheInvalidation();
+};
+
+
+
+/**
+ * Actor的属性快照，在Actor第一次生成时捕获，回收时只把发生了变化的属性恢复为快照中的值
+ */
+class TIREFLYACTORPOOL_API FTireflyActorStateSnapshot
+{
+public:
+	explicit FTireflyActorStateSnapshot(const AActor* Actor);
+
+	~FTireflyActorStateSnapshot();
+
+	FTireflyActorStateSnapshot(const FTireflyActorStateSnapshot&) = delete;
+	FTireflyActorStateSnapshot& operator=(const FTireflyActorStateSnapshot&) = delete;
+
+	/**
+	 * 把Actor中与快照不同的属性恢复为快照中的值
+	 *
+	 * @param Actor 要恢复的Actor，必须与捕获快照的Actor属于同一类型
+	 * @return 被恢复的属性数量
+	 */
+	int32 Restore(AActor* Actor) const;
+
+private:
+	TSharedRef<const FTireflyActorResetLayout> Layout;
+
+	uint8* Buffer = nullptr;
+
+	TArray<TWeakObjectPtr<UObject>> ObjectValues;
+};
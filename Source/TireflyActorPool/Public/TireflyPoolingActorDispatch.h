@@ -0,0 +1,69 @@
+// Copyright Tirefly. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TireflyPoolingDispatchCache.h"
+
+
+class ITireflyPoolingActorInterface;
+class UTireflyPoolingActorInterface;
+struct FInstancedStruct;
+
+
+
+/**
+ * ITireflyPoolingActorInterface的快速调用路径
+ *
+ * Execute_前缀的调用每次都要查找UFunction并经过ProcessEvent，即使是纯C++类也是如此。
+ * 这里按Actor类型缓存一份调用记录：没有被蓝图覆盖的事件直接调用C++的_Implementation虚函数，
+ * 被蓝图覆盖的事件使用缓存的UFunction调用ProcessEvent。只能在游戏线程上使用。
+ */
+class TIREFLYACTORPOOL_API FTireflyPoolingActorDispatch
+{
+public:
+	// Actor类型是否实现了ITireflyPoolingActorInterface（C++或蓝图实现均可）
+	static bool Implements(const UClass* ActorClass);
+
+	static void PoolingBeginPlay(AActor* Actor);
+
+	static void PoolingInitialized(AActor* Actor, const FInstancedStruct& InitialData);
+
+	static void PoolingEndPlay(AActor* Actor);
+
+	static void PoolingWarmUp(AActor* Actor);
+
+	static FName PoolingGetActorId(AActor* Actor);
+
+	static void PoolingSetActorId(AActor* Actor, FName NewActorId);
+
+	// 清空缓存的调用记录，缓存的UFunction在蓝图重新编译、热重载或游戏世界被清理后可能已经失效
+	static void ResetCache();
+
+private:
+	enum class EEvent : uint8
+	{
+		BeginPlay,
+		Initialized,
+		EndPlay,
+		WarmUp,
+		GetActorId,
+		SetActorId,
+		Num,
+	};
+
+	using FCache = TTireflyPoolingDispatchCache<UTireflyPoolingActorInterface, ITireflyPoolingActorInterface, static_cast<int32>(EEvent::Num)>;
+	using FRecord = FCache::FRecord;
+
+	// 各个Actor类型的调用记录
+	static FCache Cache;
+
+	static const FRecord& GetRecord(const UClass* ActorClass);
+
+	static ITireflyPoolingActorInterface* GetNativeInterface(AActor* Actor, const FRecord& Record);
+
+	static UFunction* GetScriptFunction(const FRecord& Record, EEvent Event)
+	{
+		return Record.GetScriptFunction(static_cast<int32>(Event));
+	}
+};
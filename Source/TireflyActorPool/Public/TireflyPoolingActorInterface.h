@@ -16,7 +16,14 @@ class UTireflyPoolingActorInterface : public UInterface
 };
 
 
-// Actor池生成的Actor需要实现的接口
+/**
+ * Actor池生成的Actor需要实现的接口
+ *
+ * 每次从对象池中取出Actor时的调用顺序固定为 PoolingBeginPlay -> PoolingInitialized（有初始化数据时），回收时调用PoolingEndPlay：
+ * - 复用待命的Actor：PoolingBeginPlay -> PoolingInitialized
+ * - 即时生成：PoolingSetActorId -> 构造脚本和BeginPlay -> PoolingBeginPlay -> PoolingInitialized
+ * - 开启了bDeferredColdSpawn的即时生成：PoolingSetActorId -> PoolingBeginPlay -> PoolingInitialized -> 构造脚本和BeginPlay
+ */
 class TIREFLYACTORPOOL_API ITireflyPoolingActorInterface
 {
 	GENERATED_BODY()
@@ -28,6 +35,7 @@ public:
 	virtual void PoolingBeginPlay_Implementation() {}
 
 	// Actor从对象池中生成后执行的初始化，通过InstancedStruct进行属性初始化
+	// 总是在PoolingBeginPlay之后调用；对象池开启了bDeferredColdSpawn时，即时生成的Actor会在构造脚本和BeginPlay之前收到该调用，此时组件尚未注册
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Tirefly Actor Pool")
 	void PoolingInitialized(const FInstancedStruct& InitialData);
 	virtual void PoolingInitialized_Implementation(const FInstancedStruct& InitialData) {}
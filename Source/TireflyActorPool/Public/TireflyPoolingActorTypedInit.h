@@ -0,0 +1,92 @@
+// Copyright Tirefly. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+
+
+struct FInstancedStruct;
+
+
+
+/**
+ * C++类型化初始化数据的接口，与ITireflyPoolingActorInterface一起由C++ Actor实现
+ *
+ * 通过SpawnActorFromPool<TActor, TInit>生成Actor时，初始化数据以常量引用直接传给PoolingInitializedTyped，
+ * 不构造FInstancedStruct，也不需要在接收方做类型检查。一个Actor可以为多种TInit分别实现该接口。
+ * PoolingInitializedTyped代替PoolingInitialized被调用，调用时机相同；蓝图仍然使用FInstancedStruct的版本。
+ */
+template<typename TInit>
+class TTireflyPoolingActorTypedInit
+{
+public:
+	virtual ~TTireflyPoolingActorTypedInit() = default;
+
+	// Actor从对象池中生成后执行的初始化
+	virtual void PoolingInitializedTyped(const TInit& InitialData) = 0;
+};
+
+
+
+namespace TireflyActorPool
+{
+	// 可以作为C++类型化初始化数据的类型，指针和FInstancedStruct仍然走FInstancedStruct的版本
+	template<typename TInit>
+	inline constexpr bool TIsTypedInitialData = !std::is_pointer_v<TInit> && !std::is_null_pointer_v<TInit> && !std::is_same_v<TInit, FInstancedStruct>;
+}
+
+
+
+// 对象池内部传递的初始化数据，指向FInstancedStruct或C++类型化的初始化数据，不持有也不复制数据
+struct TIREFLYACTORPOOL_API FTireflyPoolingInitialDataRef
+{
+public:
+	FTireflyPoolingInitialDataRef() = default;
+
+	FTireflyPoolingInitialDataRef(const FInstancedStruct* InInstancedStruct)
+		: InstancedStruct(InInstancedStruct)
+	{}
+
+	// 引用TActor的C++类型化初始化数据，Data需要在生成期间保持有效
+	template<typename TActor, typename TInit>
+	static FTireflyPoolingInitialDataRef MakeTyped(const TInit& Data)
+	{
+		static_assert(TIsDerivedFrom<TActor, TTireflyPoolingActorTypedInit<TInit>>::Value, "Typed initial data requires the actor class to implement TTireflyPoolingActorTypedInit<TInit>.");
+
+		FTireflyPoolingInitialDataRef Ref;
+		Ref.TypedData = &Data;
+		Ref.ApplyTyped = [](AActor* Actor, const void* InData) -> bool
+		{
+			// Id对象池中可能混有其他类型的Actor，此时无法接收该类型的初始化数据
+			TActor* TypedActor = Cast<TActor>(Actor);
+			if (!TypedActor)
+			{
+				return false;
+			}
+
+			static_cast<TTireflyPoolingActorTypedInit<TInit>*>(TypedActor)->PoolingInitializedTyped(*static_cast<const TInit*>(InData));
+			return true;
+		};
+		return Ref;
+	}
+
+	bool IsSet() const { return InstancedStruct || TypedData; }
+
+	// 是否引用C++类型化的初始化数据
+	bool IsTyped() const { return TypedData != nullptr; }
+
+	const FInstancedStruct* GetInstancedStruct() const { return InstancedStruct; }
+
+	void Reset() { *this = FTireflyPoolingInitialDataRef(); }
+
+	// 把初始化数据应用到Actor上：FInstancedStruct调用PoolingInitialized，类型化数据调用PoolingInitializedTyped
+	void Apply(AActor* Actor) const;
+
+private:
+	const FInstancedStruct* InstancedStruct = nullptr;
+
+	const void* TypedData = nullptr;
+
+	bool (*ApplyTyped)(AActor* Actor, const void* Data) = nullptr;
+};
@@ -0,0 +1,114 @@
+// Copyright Tirefly. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Class.h"
+#include "UObject/ObjectKey.h"
+
+
+
+/**
+ * 对象池接口快速调用路径共用的调用记录缓存，FTireflyPoolingActorDispatch和FTireflyPoolingObjectDispatch各持有一份
+ *
+ * 按类型缓存接口的实现情况：C++接口相对对象指针的偏移，以及被蓝图覆盖（或只在蓝图中实现）的事件对应的UFunction。
+ * 缓存的UFunction在蓝图重新编译、热重载或游戏世界被清理后可能已经失效，需要通过Reset清空。只能在游戏线程上使用。
+ *
+ * @tparam UInterfaceType 接口的UInterface类型
+ * @tparam IInterfaceType 接口的C++类型
+ * @tparam EventNum 接口事件的数量
+ */
+template<typename UInterfaceType, typename IInterfaceType, int32 EventNum>
+class TTireflyPoolingDispatchCache
+{
+public:
+	// 一个类型的调用记录
+	struct FRecord
+	{
+		// 是否实现了接口
+		bool bImplementsInterface = false;
+
+		// 接口在C++对象中相对对象指针的偏移，只有在C++中实现接口时有效
+		int32 NativeInterfaceOffset = INDEX_NONE;
+
+		// 每个事件被蓝图覆盖时对应的UFunction，为空且NativeInterfaceOffset有效时直接调用_Implementation
+		UFunction* ScriptFunctions[EventNum] = {};
+
+		UFunction* GetScriptFunction(int32 Event) const
+		{
+			return ScriptFunctions[Event];
+		}
+
+		IInterfaceType* GetNativeInterface(UObject* Object) const
+		{
+			if (NativeInterfaceOffset == INDEX_NONE)
+			{
+				return nullptr;
+			}
+
+			return reinterpret_cast<IInterfaceType*>(reinterpret_cast<uint8*>(Object) + NativeInterfaceOffset);
+		}
+	};
+
+	/**
+	 * 获取类型的调用记录，第一次使用时构建并缓存
+	 *
+	 * @param Class 对象的类型
+	 * @param EventNames 各个事件的函数名，顺序与FRecord::ScriptFunctions一致
+	 */
+	const FRecord& Get(const UClass* Class, const FName (&EventNames)[EventNum])
+	{
+		const TObjectKey<UClass> ClassKey(Class);
+		if (LastRecord && LastClass == ClassKey)
+		{
+			return *LastRecord;
+		}
+
+		TUniquePtr<FRecord>& Record = Records.FindOrAdd(ClassKey);
+		if (!Record)
+		{
+			Record = MakeUnique<FRecord>();
+			Record->bImplementsInterface = Class->ImplementsInterface(UInterfaceType::StaticClass());
+
+			if (Record->bImplementsInterface)
+			{
+				// 同一类型的对象内存布局相同，用CDO计算C++接口的偏移
+				const UObject* DefaultObject = Class->GetDefaultObject();
+				if (const void* NativeInterface = DefaultObject->GetNativeInterfaceAddress(UInterfaceType::StaticClass()))
+				{
+					Record->NativeInterfaceOffset = static_cast<int32>(static_cast<const uint8*>(NativeInterface) - reinterpret_cast<const uint8*>(DefaultObject));
+				}
+
+				for (int32 Index = 0; Index < EventNum; ++Index)
+				{
+					// 找到的函数不是C++函数说明被蓝图覆盖了；只在蓝图中实现接口时也只能通过ProcessEvent调用
+					UFunction* Function = Class->FindFunctionByName(EventNames[Index]);
+					if (Function && (!Function->HasAnyFunctionFlags(FUNC_Native) || Record->NativeInterfaceOffset == INDEX_NONE))
+					{
+						Record->ScriptFunctions[Index] = Function;
+					}
+				}
+			}
+		}
+
+		LastClass = ClassKey;
+		LastRecord = Record.Get();
+		return *Record;
+	}
+
+	// 清空所有缓存的调用记录
+	void Reset()
+	{
+		LastClass = TObjectKey<UClass>();
+		LastRecord = nullptr;
+		Records.Empty();
+	}
+
+private:
+	// 各个类型的调用记录，值单独分配，保证返回的引用在映射扩容后仍然有效
+	TMap<TObjectKey<UClass>, TUniquePtr<FRecord>> Records;
+
+	// 同一类型的对象往往连续取出和回收，先检查上一次使用的类型
+	TObjectKey<UClass> LastClass;
+	const FRecord* LastRecord = nullptr;
+};
@@ -0,0 +1,61 @@
+// Copyright Tirefly. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TireflyPoolingDispatchCache.h"
+
+
+class ITireflyPoolingObjectInterface;
+class UTireflyPoolingObjectInterface;
+struct FInstancedStruct;
+
+
+
+/**
+ * ITireflyPoolingObjectInterface的快速调用路径，与FTireflyPoolingActorDispatch相同，
+ * 按对象类型缓存一份调用记录：没有被蓝图覆盖的事件直接调用C++的_Implementation虚函数，
+ * 被蓝图覆盖的事件使用缓存的UFunction调用ProcessEvent。只能在游戏线程上使用。
+ */
+class TIREFLYACTORPOOL_API FTireflyPoolingObjectDispatch
+{
+public:
+	// 对象类型是否实现了ITireflyPoolingObjectInterface（C++或蓝图实现均可）
+	static bool Implements(const UClass* ObjectClass);
+
+	static void PoolingBeginPlay(UObject* Object);
+
+	static void PoolingInitialized(UObject* Object, const FInstancedStruct& InitialData);
+
+	static void PoolingEndPlay(UObject* Object);
+
+	static void PoolingWarmUp(UObject* Object);
+
+	// 清空缓存的调用记录，缓存的UFunction在蓝图重新编译、热重载或游戏世界被清理后可能已经失效
+	static void ResetCache();
+
+private:
+	enum class EEvent : uint8
+	{
+		BeginPlay,
+		Initialized,
+		EndPlay,
+		WarmUp,
+		Num,
+	};
+
+	using FCache = TTireflyPoolingDispatchCache<UTireflyPoolingObjectInterface, ITireflyPoolingObjectInterface, static_cast<int32>(EEvent::Num)>;
+	using FRecord = FCache::FRecord;
+
+	// 各个对象类型的调用记录
+	static FCache Cache;
+
+	static const FRecord& GetRecord(const UClass* ObjectClass);
+
+	static ITireflyPoolingObjectInterface* GetNativeInterface(UObject* Object, const FRecord& Record);
+
+	static UFunction* GetScriptFunction(const FRecord& Record, EEvent Event)
+	{
+		return Record.GetScriptFunction(static_cast<int32>(Event));
+	}
+};
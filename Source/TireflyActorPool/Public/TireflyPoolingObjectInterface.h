@@ -0,0 +1,44 @@
+// Copyright Tirefly. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "StructUtils/InstancedStruct.h"
+#include "TireflyPoolingObjectInterface.generated.h"
+
+
+
+UINTERFACE(MinimalAPI, BlueprintType)
+class UTireflyPoolingObjectInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+
+// 对象池中的组件和普通UObject可以选择实现的接口，不实现时对象池只做注册、挂接与激活等通用处理
+class TIREFLYACTORPOOL_API ITireflyPoolingObjectInterface
+{
+	GENERATED_BODY()
+
+public:
+	// 对象从对象池中取出后执行的 “对象池专属BeginPlay”，组件此时已经注册并挂接到新的Owner上
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Tirefly Actor Pool")
+	void PoolingBeginPlay();
+	virtual void PoolingBeginPlay_Implementation() {}
+
+	// 对象从对象池中取出后执行的初始化，通过InstancedStruct进行属性初始化
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Tirefly Actor Pool")
+	void PoolingInitialized(const FInstancedStruct& InitialData);
+	virtual void PoolingInitialized_Implementation(const FInstancedStruct& InitialData) {}
+
+	// 对象被放回对象池之前执行的操作，组件此时仍然注册在原来的Owner上
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Tirefly Actor Pool")
+	void PoolingEndPlay();
+	virtual void PoolingEndPlay_Implementation() {}
+
+	// 对象在对象池中预热时执行的函数
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Tirefly Actor Pool")
+	void PoolingWarmUp();
+	virtual void PoolingWarmUp_Implementation() {}
+};
@@ -37,6 +37,8 @@ public class TireflyActorPool : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"DeveloperSettings",
+				"EngineSettings",
 				"Slate",
 				"SlateCore",
 				"AIModule",
@@ -0,0 +1,91 @@
+// Copyright Tirefly. All Rights Reserved.
+
+
+#include "TireflyActorPoolBenchmarkActors.h"
+
+#include "Components/CapsuleComponent.h"
+#include "Components/SphereComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "GameFramework/FloatingPawnMovement.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "TireflyActorPoolLibrary.h"
+
+
+
+ATireflyBenchmarkActor::ATireflyBenchmarkActor()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	Collision = CreateDefaultSubobject<USphereComponent>(TEXT("Collision"));
+	Collision->SetCollisionProfileName(TEXT("BlockAllDynamic"));
+	RootComponent = Collision;
+
+	Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
+	Mesh->SetupAttachment(Collision);
+	Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	Movement = CreateDefaultSubobject<UProjectileMovementComponent>(TEXT("Movement"));
+	Movement->InitialSpeed = 1000.f;
+	Movement->ProjectileGravityScale = 0.f;
+}
+
+void ATireflyBenchmarkActor::PoolingBeginPlay_Implementation()
+{
+	UTireflyActorPoolLibrary::GenericBeginPlay_Actor(this, this);
+}
+
+void ATireflyBenchmarkActor::PoolingEndPlay_Implementation()
+{
+	UTireflyActorPoolLibrary::GenericEndPlay_Actor(this, this);
+}
+
+void ATireflyBenchmarkActor::PoolingWarmUp_Implementation()
+{
+	UTireflyActorPoolLibrary::GenericWarmUp_Actor(this, this);
+}
+
+ATireflyBenchmarkPawn::ATireflyBenchmarkPawn()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	Capsule = CreateDefaultSubobject<UCapsuleComponent>(TEXT("Capsule"));
+	Capsule->InitCapsuleSize(34.f, 88.f);
+	Capsule->SetCollisionProfileName(UCollisionProfile::Pawn_ProfileName);
+	RootComponent = Capsule;
+
+	Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
+	Mesh->SetupAttachment(Capsule);
+	Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	Movement = CreateDefaultSubobject<UFloatingPawnMovement>(TEXT("Movement"));
+}
+
+void ATireflyBenchmarkPawn::PoolingBeginPlay_Implementation()
+{
+	UTireflyActorPoolLibrary::GenericBeginPlay_Pawn(this, this);
+}
+
+void ATireflyBenchmarkPawn::PoolingEndPlay_Implementation()
+{
+	UTireflyActorPoolLibrary::GenericEndPlay_Pawn(this, this);
+}
+
+void ATireflyBenchmarkPawn::PoolingWarmUp_Implementation()
+{
+	UTireflyActorPoolLibrary::GenericWarmUp_Pawn(this, this);
+}
+
+void ATireflyBenchmarkCharacter::PoolingBeginPlay_Implementation()
+{
+	UTireflyActorPoolLibrary::GenericBeginPlay_Character(this, this);
+}
+
+void ATireflyBenchmarkCharacter::PoolingEndPlay_Implementation()
+{
+	UTireflyActorPoolLibrary::GenericEndPlay_Character(this, this);
+}
+
+void ATireflyBenchmarkCharacter::PoolingWarmUp_Implementation()
+{
+	UTireflyActorPoolLibrary::GenericWarmUp_Character(this, this);
+}
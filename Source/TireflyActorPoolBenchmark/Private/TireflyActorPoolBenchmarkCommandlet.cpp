@@ -0,0 +1,357 @@
+// Copyright Tirefly. All Rights Reserved.
+
+
+#include "TireflyActorPoolBenchmarkCommandlet.h"
+
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "TireflyActorPoolBenchmarkActors.h"
+#include "TireflyActorPoolWorldSubsystem.h"
+#include "UObject/UObjectGlobals.h"
+
+
+DEFINE_LOG_CATEGORY_STATIC(LogTireflyActorPoolBenchmark, Log, All);
+
+
+namespace TireflyActorPoolBenchmark
+{
+	// 场景的生成方式
+	enum class EMode : uint8
+	{
+		// 直接SpawnActor/Destroy
+		Raw,
+		// 对象池，每轮开始前清空对象池，所有生成都会未命中
+		PooledCold,
+		// 对象池，开始前预热到场景规模，所有生成都会命中
+		PooledWarm,
+	};
+
+	const TCHAR* LexToString(EMode Mode)
+	{
+		switch (Mode)
+		{
+		case EMode::Raw:		return TEXT("Raw");
+		case EMode::PooledCold:	return TEXT("PooledCold");
+		case EMode::PooledWarm:	return TEXT("PooledWarm");
+		default:				return TEXT("Unknown");
+		}
+	}
+
+	// 一组延迟样本（微秒）的统计结果
+	struct FLatencyStats
+	{
+		int32 Count = 0;
+		double TotalSeconds = 0.0;
+		double MeanUs = 0.0;
+		double P50Us = 0.0;
+		double P90Us = 0.0;
+		double P99Us = 0.0;
+		double MaxUs = 0.0;
+
+		double GetThroughput() const { return TotalSeconds > 0.0 ? Count / TotalSeconds : 0.0; }
+	};
+
+	struct FScenarioResult
+	{
+		FString ActorType;
+		EMode Mode = EMode::Raw;
+		int32 PoolSize = 0;
+		int32 Rounds = 0;
+		FLatencyStats Spawn;
+		FLatencyStats Release;
+	};
+
+	FLatencyStats MakeLatencyStats(TArray<double>& SamplesUs)
+	{
+		FLatencyStats Stats;
+		Stats.Count = SamplesUs.Num();
+		if (SamplesUs.IsEmpty())
+		{
+			return Stats;
+		}
+
+		SamplesUs.Sort();
+
+		double TotalUs = 0.0;
+		for (const double Sample : SamplesUs)
+		{
+			TotalUs += Sample;
+		}
+
+		auto Percentile = [&SamplesUs](double Fraction)
+		{
+			const int32 Index = FMath::Clamp(FMath::CeilToInt32(Fraction * SamplesUs.Num()) - 1, 0, SamplesUs.Num() - 1);
+			return SamplesUs[Index];
+		};
+
+		Stats.TotalSeconds = TotalUs / 1000000.0;
+		Stats.MeanUs = TotalUs / SamplesUs.Num();
+		Stats.P50Us = Percentile(0.5);
+		Stats.P90Us = Percentile(0.9);
+		Stats.P99Us = Percentile(0.99);
+		Stats.MaxUs = SamplesUs.Last();
+		return Stats;
+	}
+
+	FScenarioResult RunScenario(UWorld* World, const FString& ActorType, UClass* ActorClass, EMode Mode, int32 PoolSize, int32 Rounds)
+	{
+		UTireflyActorPoolWorldSubsystem* SubsystemAP = World->GetSubsystem<UTireflyActorPoolWorldSubsystem>();
+		SubsystemAP->ClearAllActorPools();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		if (Mode == EMode::PooledWarm)
+		{
+			SubsystemAP->WarmUpActorPool(ActorClass, NAME_None, PoolSize);
+		}
+
+		TArray<double> SpawnSamples;
+		TArray<double> ReleaseSamples;
+		SpawnSamples.Reserve(PoolSize * Rounds);
+		ReleaseSamples.Reserve(PoolSize * Rounds);
+
+		TArray<AActor*> Actors;
+		Actors.Reserve(PoolSize);
+
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		for (int32 Round = 0; Round < Rounds; ++Round)
+		{
+			if (Mode == EMode::PooledCold)
+			{
+				SubsystemAP->ClearActorPoolsOfClass(ActorClass);
+			}
+
+			for (int32 Index = 0; Index < PoolSize; ++Index)
+			{
+				// 分散摆放，避免Actor相互重叠
+				const FTransform Transform(FVector(Index % 64 * 200.0, Index / 64 * 200.0, 100.0));
+
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				AActor* Actor = Mode == EMode::Raw
+					? World->SpawnActor<AActor>(ActorClass, Transform, SpawnParameters)
+					: SubsystemAP->SpawnActorFromPool<AActor>(ActorClass, NAME_None, Transform);
+				SpawnSamples.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0);
+
+				if (Actor)
+				{
+					Actors.Add(Actor);
+				}
+			}
+
+			for (AActor* Actor : Actors)
+			{
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				if (Mode == EMode::Raw)
+				{
+					Actor->Destroy();
+				}
+				else
+				{
+					SubsystemAP->RecycleActorToPool(Actor);
+				}
+				ReleaseSamples.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0);
+			}
+			Actors.Reset();
+
+			// 垃圾回收不计入测量，但每轮都执行，保证直接销毁的场景不会堆积待回收的Actor
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+
+		SubsystemAP->ClearAllActorPools();
+
+		FScenarioResult Result;
+		Result.ActorType = ActorType;
+		Result.Mode = Mode;
+		Result.PoolSize = PoolSize;
+		Result.Rounds = Rounds;
+		Result.Spawn = MakeLatencyStats(SpawnSamples);
+		Result.Release = MakeLatencyStats(ReleaseSamples);
+		return Result;
+	}
+
+	TSharedRef<FJsonObject> LatencyStatsToJson(const FLatencyStats& Stats)
+	{
+		TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+		Object->SetNumberField(TEXT("count"), Stats.Count);
+		Object->SetNumberField(TEXT("opsPerSecond"), Stats.GetThroughput());
+		Object->SetNumberField(TEXT("meanUs"), Stats.MeanUs);
+		Object->SetNumberField(TEXT("p50Us"), Stats.P50Us);
+		Object->SetNumberField(TEXT("p90Us"), Stats.P90Us);
+		Object->SetNumberField(TEXT("p99Us"), Stats.P99Us);
+		Object->SetNumberField(TEXT("maxUs"), Stats.MaxUs);
+		return Object;
+	}
+
+	bool WriteResults(const FString& OutputBase, const TArray<FScenarioResult>& Results)
+	{
+		const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("TireflyActorPool"));
+
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetStringField(TEXT("pluginVersion"), Plugin.IsValid() ? Plugin->GetDescriptor().VersionName : TEXT("Unknown"));
+		Root->SetStringField(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+		Root->SetStringField(TEXT("buildConfiguration"), LexToString(FApp::GetBuildConfiguration()));
+		Root->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+		Root->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+
+		TArray<TSharedPtr<FJsonValue>> Scenarios;
+		FString Csv = TEXT("ActorType,Mode,PoolSize,Rounds,Operation,Count,OpsPerSecond,MeanUs,P50Us,P90Us,P99Us,MaxUs\n");
+		for (const FScenarioResult& Result : Results)
+		{
+			TSharedRef<FJsonObject> Scenario = MakeShared<FJsonObject>();
+			Scenario->SetStringField(TEXT("actorType"), Result.ActorType);
+			Scenario->SetStringField(TEXT("mode"), LexToString(Result.Mode));
+			Scenario->SetNumberField(TEXT("poolSize"), Result.PoolSize);
+			Scenario->SetNumberField(TEXT("rounds"), Result.Rounds);
+			Scenario->SetObjectField(TEXT("spawn"), LatencyStatsToJson(Result.Spawn));
+			Scenario->SetObjectField(TEXT("release"), LatencyStatsToJson(Result.Release));
+			Scenarios.Add(MakeShared<FJsonValueObject>(Scenario));
+
+			auto AppendCsvRow = [&Csv, &Result](const TCHAR* Operation, const FLatencyStats& Stats)
+			{
+				Csv += FString::Printf(TEXT("%s,%s,%d,%d,%s,%d,%.1f,%.3f,%.3f,%.3f,%.3f,%.3f\n"),
+					*Result.ActorType,
+					LexToString(Result.Mode),
+					Result.PoolSize,
+					Result.Rounds,
+					Operation,
+					Stats.Count,
+					Stats.GetThroughput(),
+					Stats.MeanUs,
+					Stats.P50Us,
+					Stats.P90Us,
+					Stats.P99Us,
+					Stats.MaxUs);
+			};
+			AppendCsvRow(TEXT("Spawn"), Result.Spawn);
+			AppendCsvRow(TEXT("Release"), Result.Release);
+		}
+		Root->SetArrayField(TEXT("scenarios"), Scenarios);
+
+		FString Json;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(Root, Writer);
+
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(OutputBase), true);
+		return FFileHelper::SaveStringToFile(Json, *(OutputBase + TEXT(".json")))
+			&& FFileHelper::SaveStringToFile(Csv, *(OutputBase + TEXT(".csv")));
+	}
+}
+
+
+UTireflyActorPoolBenchmarkCommandlet::UTireflyActorPoolBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Benchmarks Tirefly Actor Pool spawn/recycle throughput against raw SpawnActor/Destroy.");
+	HelpUsage = TEXT("-run=TireflyActorPoolBenchmark -nullrhi [-PoolSizes=16,128,1024] [-Rounds=20] [-Types=Actor,Pawn,Character] [-Output=<Path>]");
+}
+
+int32 UTireflyActorPoolBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace TireflyActorPoolBenchmark;
+
+	int32 Rounds = 20;
+	FParse::Value(*Params, TEXT("Rounds="), Rounds);
+	Rounds = FMath::Max(Rounds, 1);
+
+	TArray<int32> PoolSizes = { 16, 128, 1024 };
+	FString PoolSizesParam;
+	if (FParse::Value(*Params, TEXT("PoolSizes="), PoolSizesParam, false))
+	{
+		TArray<FString> Tokens;
+		PoolSizesParam.ParseIntoArray(Tokens, TEXT(","));
+
+		PoolSizes.Reset();
+		for (const FString& Token : Tokens)
+		{
+			const int32 PoolSize = FCString::Atoi(*Token);
+			if (PoolSize > 0)
+			{
+				PoolSizes.Add(PoolSize);
+			}
+		}
+	}
+
+	TArray<TPair<FString, UClass*>> ActorTypes = {
+		{ TEXT("Actor"), ATireflyBenchmarkActor::StaticClass() },
+		{ TEXT("Pawn"), ATireflyBenchmarkPawn::StaticClass() },
+		{ TEXT("Character"), ATireflyBenchmarkCharacter::StaticClass() },
+	};
+	FString TypesParam;
+	if (FParse::Value(*Params, TEXT("Types="), TypesParam, false))
+	{
+		ActorTypes.RemoveAll([&TypesParam](const TPair<FString, UClass*>& ActorType)
+		{
+			return !TypesParam.Contains(ActorType.Key);
+		});
+	}
+
+	FString OutputBase;
+	if (!FParse::Value(*Params, TEXT("Output="), OutputBase))
+	{
+		OutputBase = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("TireflyActorPoolBenchmark"), FDateTime::Now().ToString());
+	}
+
+	if (PoolSizes.IsEmpty() || ActorTypes.IsEmpty())
+	{
+		UE_LOG(LogTireflyActorPoolBenchmark, Error, TEXT("Nothing to run. %s"), *HelpUsage);
+		return 1;
+	}
+
+	// 创建一个不需要地图资源的游戏世界
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("TireflyActorPoolBenchmark"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	TArray<FScenarioResult> Results;
+	for (const TPair<FString, UClass*>& ActorType : ActorTypes)
+	{
+		for (const int32 PoolSize : PoolSizes)
+		{
+			for (const EMode Mode : { EMode::Raw, EMode::PooledCold, EMode::PooledWarm })
+			{
+				const FScenarioResult& Result = Results.Add_GetRef(RunScenario(World, ActorType.Key, ActorType.Value, Mode, PoolSize, Rounds));
+				UE_LOG(LogTireflyActorPoolBenchmark, Display, TEXT("%-10s %-10s %5d  spawn p50 %8.2fus p99 %8.2fus %10.0f/s  release p50 %8.2fus p99 %8.2fus %10.0f/s"),
+					*Result.ActorType,
+					LexToString(Result.Mode),
+					Result.PoolSize,
+					Result.Spawn.P50Us,
+					Result.Spawn.P99Us,
+					Result.Spawn.GetThroughput(),
+					Result.Release.P50Us,
+					Result.Release.P99Us,
+					Result.Release.GetThroughput());
+			}
+		}
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	if (!WriteResults(OutputBase, Results))
+	{
+		UE_LOG(LogTireflyActorPoolBenchmark, Error, TEXT("Failed to write results to %s"), *OutputBase);
+		return 1;
+	}
+
+	UE_LOG(LogTireflyActorPoolBenchmark, Display, TEXT("Wrote %d scenarios to %s.json/.csv"), Results.Num(), *OutputBase);
+	return 0;
+}
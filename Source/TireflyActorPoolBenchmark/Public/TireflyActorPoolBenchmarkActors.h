@@ -0,0 +1,82 @@
+// Copyright Tirefly. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/Pawn.h"
+#include "TireflyPoolingActorInterface.h"
+#include "TireflyActorPoolBenchmarkActors.generated.h"
+
+
+class UCapsuleComponent;
+class UFloatingPawnMovement;
+class UProjectileMovementComponent;
+class USphereComponent;
+class UStaticMeshComponent;
+
+
+
+// 基准测试使用的普通Actor，组件组合模拟常见的投射物：碰撞球、静态网格体、投射物移动
+UCLASS(NotBlueprintable, NotPlaceable, Transient)
+class ATireflyBenchmarkActor : public AActor, public ITireflyPoolingActorInterface
+{
+	GENERATED_BODY()
+
+public:
+	ATireflyBenchmarkActor();
+
+	virtual void PoolingBeginPlay_Implementation() override;
+	virtual void PoolingEndPlay_Implementation() override;
+	virtual void PoolingWarmUp_Implementation() override;
+
+protected:
+	UPROPERTY(VisibleAnywhere, Category = "Benchmark")
+	TObjectPtr<USphereComponent> Collision;
+
+	UPROPERTY(VisibleAnywhere, Category = "Benchmark")
+	TObjectPtr<UStaticMeshComponent> Mesh;
+
+	UPROPERTY(VisibleAnywhere, Category = "Benchmark")
+	TObjectPtr<UProjectileMovementComponent> Movement;
+};
+
+
+
+// 基准测试使用的Pawn，组件组合模拟常见的简单AI单位：胶囊体、静态网格体、浮动移动
+UCLASS(NotBlueprintable, NotPlaceable, Transient)
+class ATireflyBenchmarkPawn : public APawn, public ITireflyPoolingActorInterface
+{
+	GENERATED_BODY()
+
+public:
+	ATireflyBenchmarkPawn();
+
+	virtual void PoolingBeginPlay_Implementation() override;
+	virtual void PoolingEndPlay_Implementation() override;
+	virtual void PoolingWarmUp_Implementation() override;
+
+protected:
+	UPROPERTY(VisibleAnywhere, Category = "Benchmark")
+	TObjectPtr<UCapsuleComponent> Capsule;
+
+	UPROPERTY(VisibleAnywhere, Category = "Benchmark")
+	TObjectPtr<UStaticMeshComponent> Mesh;
+
+	UPROPERTY(VisibleAnywhere, Category = "Benchmark")
+	TObjectPtr<UFloatingPawnMovement> Movement;
+};
+
+
+
+// 基准测试使用的Character，使用Character默认的胶囊体、骨骼网格体和角色移动组件
+UCLASS(NotBlueprintable, NotPlaceable, Transient)
+class ATireflyBenchmarkCharacter : public ACharacter, public ITireflyPoolingActorInterface
+{
+	GENERATED_BODY()
+
+public:
+	virtual void PoolingBeginPlay_Implementation() override;
+	virtual void PoolingEndPlay_Implementation() override;
+	virtual void PoolingWarmUp_Implementation() override;
+};
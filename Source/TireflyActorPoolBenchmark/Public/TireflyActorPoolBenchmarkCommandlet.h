@@ -0,0 +1,30 @@
+// Copyright Tirefly. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TireflyActorPoolBenchmarkCommandlet.generated.h"
+
+
+
+/**
+ * 对象池的无界面基准测试，比较对象池生成/回收与直接SpawnActor/Destroy的吞吐量和延迟分位数
+ *
+ * 用法：
+ *   UnrealEditor-Cmd <Project>.uproject -run=TireflyActorPoolBenchmark -nullrhi -unattended
+ *     [-PoolSizes=16,128,1024] [-Rounds=20] [-Types=Actor,Pawn,Character] [-Output=<不含扩展名的文件路径>]
+ *
+ * 每个场景会在Output（默认为Saved/TireflyActorPoolBenchmark/<时间戳>）写出同名的.json和.csv结果，
+ * 便于在插件版本之间比较性能回退。
+ */
+UCLASS()
+class UTireflyActorPoolBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTireflyActorPoolBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
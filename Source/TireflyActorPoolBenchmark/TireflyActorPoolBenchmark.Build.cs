@@ -0,0 +1,30 @@
+// Copyright Tirefly. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class TireflyActorPoolBenchmark : ModuleRules
+{
+	public TireflyActorPoolBenchmark(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+			}
+			);
+			
+		
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"CoreUObject",
+				"Engine",
+				"Json",
+				"Projects",
+				"TireflyActorPool",
+			}
+			);
+	}
+}
@@ -0,0 +1,6 @@
+// Copyright Tirefly. All Rights Reserved.
+
+#include "TireflyActorPoolBenchmarkModule.h"
+
+
+IMPLEMENT_MODULE(FTireflyActorPoolBenchmarkModule, TireflyActorPoolBenchmark)
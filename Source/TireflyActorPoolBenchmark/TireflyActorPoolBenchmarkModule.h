@@ -0,0 +1,11 @@
+// Copyright Tirefly. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+
+
+class FTireflyActorPoolBenchmarkModule : public IModuleInterface
+{
+};